@@ -0,0 +1,141 @@
+// src/Animation.cpp
+#include "Animation.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Log.h"
+
+namespace anim {
+
+int AnimSet::find(const char* name, int fallback) const {
+  for (size_t i = 0; i < clips.size(); ++i) {
+    if (clips[i].name == name) return (int)i;
+  }
+  return fallback;
+}
+
+namespace {
+
+// "0-4,6" -> 0 1 2 3 4 6. Rejects indices outside [0, cellCount).
+bool parseFrames(const char* spec, int cellCount, std::vector<int>& out) {
+  out.clear();
+  const char* p = spec;
+  while (*p) {
+    char* end = nullptr;
+    const long a = std::strtol(p, &end, 10);
+    if (end == p) return false;
+    long b = a;
+    p = end;
+    if (*p == '-') {
+      b = std::strtol(p + 1, &end, 10);
+      if (end == p + 1) return false;
+      p = end;
+    }
+    if (a < 0 || b < 0 || a >= cellCount || b >= cellCount) return false;
+
+    const long step = b >= a ? 1 : -1;
+    for (long i = a; ; i += step) {
+      out.push_back((int)i);
+      if (i == b) break;
+    }
+    if (*p == ',') ++p;
+    else if (*p) return false;
+  }
+  return !out.empty();
+}
+
+bool parseMode(const char* s, LoopMode& out) {
+  if (std::strcmp(s, "loop") == 0) { out = LoopMode::Loop; return true; }
+  if (std::strcmp(s, "once") == 0) { out = LoopMode::Once; return true; }
+  if (std::strcmp(s, "pingpong") == 0) { out = LoopMode::PingPong; return true; }
+  return false;
+}
+
+std::string directoryOf(const char* path) {
+  const char* slash = std::strrchr(path, '/');
+  return slash ? std::string(path, (size_t)(slash - path + 1)) : std::string();
+}
+
+void setFallback(AnimSet& out) {
+  out.clips.clear();
+  Clip c;
+  c.name = "default";
+  c.frames.push_back(0);
+  c.mode = LoopMode::Once;
+  out.clips.push_back(c);
+}
+
+} // namespace
+
+bool load(const char* path, AnimSet& out) {
+  out = AnimSet{};
+
+  std::FILE* f = path ? std::fopen(path, "r") : nullptr;
+  if (!f) {
+    LOG_WARN("Animation file missing: %s", path ? path : "(null)");
+    setFallback(out);
+    return false;
+  }
+
+  bool haveSheet = false;
+  bool ok = true;
+  char line[256];
+  int lineNo = 0;
+
+  while (ok && std::fgets(line, sizeof(line), f)) {
+    ++lineNo;
+    char* hash = std::strchr(line, '#');
+    if (hash) *hash = '\0';
+
+    char kind[16] = {};
+    if (std::sscanf(line, "%15s", kind) != 1) continue; // blank / comment
+
+    if (std::strcmp(kind, "sheet") == 0) {
+      char image[128] = {};
+      if (std::sscanf(line, "%*s %127s %d %d", image, &out.cols, &out.rows) != 3 ||
+          out.cols <= 0 || out.rows <= 0) {
+        ok = false;
+        break;
+      }
+      out.imagePath = directoryOf(path) + image;
+      haveSheet = true;
+    } else if (std::strcmp(kind, "clip") == 0 && haveSheet) {
+      char name[64] = {}, frames[128] = {}, mode[16] = {};
+      Clip c;
+      ok = std::sscanf(line, "%*s %63s %127s %f %15s", name, frames, &c.fps, mode) == 4 &&
+           c.fps > 0.0f && parseMode(mode, c.mode) &&
+           parseFrames(frames, out.cols * out.rows, c.frames);
+      c.name = name;
+      if (ok) out.clips.push_back(c);
+    } else {
+      ok = false;
+    }
+  }
+  std::fclose(f);
+
+  if (!ok || !haveSheet || out.clips.empty()) {
+    LOG_ERROR("Animation file rejected (%s): line %d", path, lineNo);
+    setFallback(out);
+    return false;
+  }
+  return true;
+}
+
+void advance(Playback* first, size_t stride, int count, float dt) {
+  unsigned char* p = (unsigned char*)first;
+  for (int i = 0; i < count; ++i, p += stride) ((Playback*)p)->t += dt;
+}
+
+void resolve(const AnimSet& set, const Playback* first, size_t stride,
+             const int* indices, int count, int* outFrames) {
+  const unsigned char* base = (const unsigned char*)first;
+  const int clipCount = (int)set.clips.size();
+  for (int i = 0; i < count; ++i) {
+    const Playback& pb = *(const Playback*)(base + (size_t)indices[i] * stride);
+    outFrames[i] = pb.clip < clipCount ? frameAt(set.clips[pb.clip], pb.t) : 0;
+  }
+}
+
+} // namespace anim
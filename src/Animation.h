@@ -0,0 +1,72 @@
+// src/Animation.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Sprite animation clips described by a small text file next to the sheet
+// (assets/sprites/<name>.anim):
+//
+//   sheet player_sheet.png 5 2        image (same directory), cols, rows
+//   clip run 0-4 12 loop              name, frames, fps, loop|once|pingpong
+//
+// Frames are row-major cell indices of the sheet ("0-4", "5", "0,2,4-6").
+// Everything is resolved at load, so picking a frame at render time is
+// arithmetic plus one table lookup; a new character is a new .anim file.
+namespace anim {
+
+enum class LoopMode : uint8_t { Loop, Once, PingPong };
+
+struct Clip {
+  std::string name;
+  std::vector<int> frames;   // sheet frame indices, in play order
+  float fps = 10.0f;
+  LoopMode mode = LoopMode::Loop;
+};
+
+struct AnimSet {
+  std::string imagePath;     // resolved relative to the .anim file
+  int cols = 1;
+  int rows = 1;
+  std::vector<Clip> clips;
+
+  // Clip index by name, or `fallback` when missing.
+  int find(const char* name, int fallback = 0) const;
+};
+
+// Parses `path`. On failure returns false, prints why, and leaves `out` as
+// a one-clip set showing frame 0 so callers can still draw something.
+bool load(const char* path, AnimSet& out);
+
+// Sheet frame shown `t` seconds into `clip`.
+inline int frameAt(const Clip& clip, float t) {
+  const int n = (int)clip.frames.size();
+  if (n <= 1) return n == 1 ? clip.frames[0] : 0;
+
+  int i = t > 0.0f ? (int)(t * clip.fps) : 0;
+  switch (clip.mode) {
+    case LoopMode::Loop:     i %= n; break;
+    case LoopMode::Once:     if (i >= n) i = n - 1; break;
+    case LoopMode::PingPong: i %= (2 * n - 2); if (i >= n) i = 2 * n - 2 - i; break;
+  }
+  return clip.frames[(size_t)i];
+}
+
+// Per-entity playback state: which clip and how far into it.
+struct Playback {
+  uint16_t clip = 0;
+  float t = 0.0f;
+};
+
+// Advances `count` playbacks laid out `stride` bytes apart (so it can walk
+// a packed component array directly).
+void advance(Playback* first, size_t stride, int count, float dt);
+
+// Resolves sheet frames for the playbacks at `indices` (into the strided
+// array) into `outFrames`, so one sheet's entities can be picked out of a
+// mixed array.
+void resolve(const AnimSet& set, const Playback* first, size_t stride,
+             const int* indices, int count, int* outFrames);
+
+} // namespace anim
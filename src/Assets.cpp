@@ -1,28 +1,18 @@
 // src/Assets.cpp
 #include "Assets.h"
 
-#include <SDL2/SDL_image.h>
-#include <cstdio>
+#include "Log.h"
+#include "TextureRegistry.h"
 
 SDL_Texture* loadTexture(SDL_Renderer* r, const std::string& path) {
   if (!r) {
-    std::printf("loadTexture: renderer is null (%s)\n", path.c_str());
+    LOG_ERROR("loadTexture: renderer is null (%s)", path.c_str());
     return nullptr;
   }
 
-  SDL_Surface* surf = IMG_Load(path.c_str());
-  if (!surf) {
-    std::printf("IMG_Load failed (%s): %s\n", path.c_str(), IMG_GetError());
-    return nullptr;
-  }
-
-  SDL_Texture* tex = SDL_CreateTextureFromSurface(r, surf);
-  SDL_FreeSurface(surf);
-
-  if (!tex) {
-    std::printf("SDL_CreateTextureFromSurface failed (%s): %s\n", path.c_str(), SDL_GetError());
-    return nullptr;
-  }
+  // registry logs failures and applies the texture budget
+  SDL_Texture* tex = textures::load(r, path.c_str());
+  if (!tex) return nullptr;
 
   // Helpful defaults (safe for both native + web)
   SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
@@ -31,10 +21,7 @@ SDL_Texture* loadTexture(SDL_Renderer* r, const std::string& path) {
 }
 
 void destroyTexture(SDL_Texture*& tex) {
-  if (tex) {
-    SDL_DestroyTexture(tex);
-    tex = nullptr;
-  }
+  textures::destroy(tex);
 }
 
 void drawTexture(SDL_Renderer* r, SDL_Texture* tex, const SDL_FRect& dst) {
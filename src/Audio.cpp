@@ -0,0 +1,433 @@
+// src/Audio.cpp
+#include "Audio.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Log.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define AUDIO_SSE2 1
+#endif
+
+namespace audio {
+
+namespace {
+
+constexpr int kVoices = 16;
+constexpr uint32_t kQueueSize = 64; // power of two
+constexpr int kRequestFreq = 48000;
+constexpr int kRequestFrames = 512; // ~10.7 ms at 48 kHz
+constexpr int kSoundCount = (int)Sound::Count;
+
+const char* const kSoundNames[kSoundCount] = {
+  "jump", "land", "duck", "bull_step", "caught", "goal"
+};
+
+struct Command {
+  enum Kind : uint8_t { Play, StopAll } kind = Play;
+  Sound sound = Sound::Jump;
+  float gainL = 0.0f;
+  float gainR = 0.0f;
+  Uint64 stamp = 0;
+};
+
+// Owned by the callback thread once the device is running.
+struct Voice {
+  const float* pcm = nullptr;
+  uint32_t len = 0;
+  uint32_t pos = 0;
+  float gainL = 0.0f;
+  float gainR = 0.0f;
+};
+
+struct State {
+  SDL_AudioDeviceID device = 0;
+  int freq = 0;
+  int bufferFrames = 0;
+  double ticksToMs = 0.0;
+
+  std::vector<float> samples[kSoundCount]; // mono, device rate
+  Voice voices[kVoices];
+
+  // SPSC ring: head is written by play(), tail by the callback.
+  Command queue[kQueueSize];
+  std::atomic<uint32_t> head{ 0 };
+  std::atomic<uint32_t> tail{ 0 };
+
+  // Stats. Each counter has a single writer, so plain load/store suffices.
+  std::atomic<uint64_t> dropped{ 0 };
+  std::atomic<uint64_t> callbacks{ 0 };
+  std::atomic<uint64_t> mixTicks{ 0 };
+  std::atomic<uint64_t> mixTicksMax{ 0 };
+  std::atomic<uint64_t> commands{ 0 };
+  std::atomic<uint64_t> queueTicks{ 0 };
+  std::atomic<uint64_t> queueTicksMax{ 0 };
+  std::atomic<int> active{ 0 };
+};
+
+State g;
+
+void bump(std::atomic<uint64_t>& a, uint64_t v) {
+  a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+void bumpMax(std::atomic<uint64_t>& a, uint64_t v) {
+  if (v > a.load(std::memory_order_relaxed)) a.store(v, std::memory_order_relaxed);
+}
+
+// ---- sample cache ---------------------------------------------------------
+
+// Tiny deterministic noise so synthesized sounds are identical every run.
+struct Noise {
+  uint32_t s = 0x1234567u;
+  float next() {
+    s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+    return (float)(s >> 8) * (2.0f / 16777216.0f) - 1.0f;
+  }
+};
+
+constexpr float kTwoPi = 6.28318531f;
+
+std::vector<float> synthesize(Sound s, int freq) {
+  auto frames = [freq](float seconds) { return (size_t)(seconds * (float)freq); };
+  const float dt = 1.0f / (float)freq;
+  std::vector<float> out;
+  Noise noise;
+  float phase = 0.0f;
+
+  switch (s) {
+    case Sound::Jump: { // rising chirp
+      out.resize(frames(0.14f));
+      for (size_t i = 0; i < out.size(); ++i) {
+        const float t = (float)i / (float)out.size();
+        phase += kTwoPi * (320.0f + 700.0f * t) * dt;
+        out[i] = 0.35f * std::sin(phase) * (1.0f - t);
+      }
+      break;
+    }
+    case Sound::Land: { // low thump + filtered noise
+      out.resize(frames(0.10f));
+      float lp = 0.0f;
+      for (size_t i = 0; i < out.size(); ++i) {
+        const float t = (float)i * dt;
+        lp += 0.15f * (noise.next() - lp);
+        phase += kTwoPi * 90.0f * dt;
+        out[i] = (0.45f * std::sin(phase) + 0.5f * lp) * std::exp(-t * 40.0f);
+      }
+      break;
+    }
+    case Sound::Duck: { // short falling square blip
+      out.resize(frames(0.07f));
+      for (size_t i = 0; i < out.size(); ++i) {
+        const float t = (float)i / (float)out.size();
+        phase += kTwoPi * (240.0f - 90.0f * t) * dt;
+        out[i] = (std::sin(phase) >= 0.0f ? 0.18f : -0.18f) * (1.0f - t);
+      }
+      break;
+    }
+    case Sound::BullStep: { // heavy hoof thud
+      out.resize(frames(0.09f));
+      float lp = 0.0f;
+      for (size_t i = 0; i < out.size(); ++i) {
+        const float t = (float)i * dt;
+        lp += 0.05f * (noise.next() - lp);
+        phase += kTwoPi * (70.0f - 200.0f * t) * dt;
+        out[i] = (0.5f * std::sin(phase) + 0.8f * lp) * std::exp(-t * 45.0f);
+      }
+      break;
+    }
+    case Sound::Caught: { // low buzzing saw with vibrato
+      out.resize(frames(0.55f));
+      for (size_t i = 0; i < out.size(); ++i) {
+        const float t = (float)i * dt;
+        phase += (110.0f + 6.0f * std::sin(kTwoPi * 7.0f * t)) * dt;
+        phase -= std::floor(phase);
+        out[i] = 0.3f * (2.0f * phase - 1.0f) * (1.0f - t / 0.55f);
+      }
+      break;
+    }
+    case Sound::Goal: { // major arpeggio
+      const float notes[4] = { 523.25f, 659.25f, 783.99f, 1046.5f };
+      const size_t step = frames(0.09f);
+      out.resize(step * 4 + frames(0.15f));
+      for (size_t i = 0; i < out.size(); ++i) {
+        const size_t n = std::min<size_t>(i / step, 3);
+        const float local = (float)(i - n * step) * dt;
+        phase += kTwoPi * notes[n] * dt;
+        out[i] = 0.3f * std::sin(phase) * std::exp(-local * 10.0f);
+      }
+      break;
+    }
+    case Sound::Count:
+      break;
+  }
+  return out;
+}
+
+// Loads a WAV and converts it to mono float at the device rate.
+bool loadWav(const std::string& path, int freq, std::vector<float>& out) {
+  SDL_AudioSpec spec{};
+  Uint8* buf = nullptr;
+  Uint32 len = 0;
+  if (!SDL_LoadWAV(path.c_str(), &spec, &buf, &len)) return false;
+
+  SDL_AudioCVT cvt{};
+  const int rc = SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_F32SYS, 1, freq);
+  if (rc < 0) {
+    SDL_FreeWAV(buf);
+    return false;
+  }
+
+  std::vector<Uint8> work((size_t)len * (size_t)std::max(1, cvt.len_mult));
+  std::memcpy(work.data(), buf, len);
+  SDL_FreeWAV(buf);
+
+  cvt.buf = work.data();
+  cvt.len = (int)len;
+  if (rc > 0 && SDL_ConvertAudio(&cvt) != 0) return false;
+
+  const size_t bytes = rc > 0 ? (size_t)cvt.len_cvt : (size_t)len;
+  out.resize(bytes / sizeof(float));
+  std::memcpy(out.data(), work.data(), out.size() * sizeof(float));
+  return !out.empty();
+}
+
+// ---- mixer (audio thread) -------------------------------------------------
+
+// Adds `frames` mono samples into interleaved stereo `out` with per-channel gain.
+void mixVoice(float* out, const float* in, int frames, float gainL, float gainR) {
+  int i = 0;
+#ifdef AUDIO_SSE2
+  const __m128 gl = _mm_set1_ps(gainL);
+  const __m128 gr = _mm_set1_ps(gainR);
+  for (; i + 4 <= frames; i += 4) {
+    const __m128 m = _mm_loadu_ps(in + i);
+    const __m128 l = _mm_mul_ps(m, gl);
+    const __m128 r = _mm_mul_ps(m, gr);
+    float* o = out + i * 2;
+    _mm_storeu_ps(o,     _mm_add_ps(_mm_loadu_ps(o),     _mm_unpacklo_ps(l, r)));
+    _mm_storeu_ps(o + 4, _mm_add_ps(_mm_loadu_ps(o + 4), _mm_unpackhi_ps(l, r)));
+  }
+#endif
+  for (; i < frames; ++i) {
+    out[i * 2]     += in[i] * gainL;
+    out[i * 2 + 1] += in[i] * gainR;
+  }
+}
+
+void clip(float* out, int count) {
+  int i = 0;
+#ifdef AUDIO_SSE2
+  const __m128 lo = _mm_set1_ps(-1.0f);
+  const __m128 hi = _mm_set1_ps(1.0f);
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(out + i, _mm_min_ps(hi, _mm_max_ps(lo, _mm_loadu_ps(out + i))));
+  }
+#endif
+  for (; i < count; ++i) out[i] = std::clamp(out[i], -1.0f, 1.0f);
+}
+
+// Free voice, or the one furthest through its sample if all are busy.
+Voice& pickVoice() {
+  Voice* best = &g.voices[0];
+  for (Voice& v : g.voices) {
+    if (!v.pcm) return v;
+    if (v.pos * (uint64_t)best->len > best->pos * (uint64_t)v.len) best = &v;
+  }
+  return *best;
+}
+
+void drainCommands(Uint64 now) {
+  uint32_t tail = g.tail.load(std::memory_order_relaxed);
+  const uint32_t head = g.head.load(std::memory_order_acquire);
+
+  while (tail != head) {
+    const Command& c = g.queue[tail & (kQueueSize - 1)];
+    if (c.kind == Command::StopAll) {
+      for (Voice& v : g.voices) v.pcm = nullptr;
+    } else {
+      const std::vector<float>& pcm = g.samples[(int)c.sound];
+      if (!pcm.empty()) {
+        Voice& v = pickVoice();
+        v.pcm = pcm.data();
+        v.len = (uint32_t)pcm.size();
+        v.pos = 0;
+        v.gainL = c.gainL;
+        v.gainR = c.gainR;
+      }
+    }
+
+    const uint64_t waited = now > c.stamp ? now - c.stamp : 0;
+    bump(g.commands, 1);
+    bump(g.queueTicks, waited);
+    bumpMax(g.queueTicksMax, waited);
+    ++tail;
+  }
+  g.tail.store(tail, std::memory_order_release);
+}
+
+void SDLCALL callback(void*, Uint8* stream, int len) {
+  const Uint64 t0 = SDL_GetPerformanceCounter();
+  float* out = (float*)stream;
+  const int frames = len / (int)(sizeof(float) * 2);
+  std::memset(stream, 0, (size_t)len);
+
+  drainCommands(t0);
+
+  int active = 0;
+  for (Voice& v : g.voices) {
+    if (!v.pcm) continue;
+    const int n = (int)std::min<uint32_t>((uint32_t)frames, v.len - v.pos);
+    mixVoice(out, v.pcm + v.pos, n, v.gainL, v.gainR);
+    v.pos += (uint32_t)n;
+    if (v.pos >= v.len) v.pcm = nullptr;
+    else ++active;
+  }
+  clip(out, frames * 2);
+
+  const uint64_t spent = SDL_GetPerformanceCounter() - t0;
+  bump(g.callbacks, 1);
+  bump(g.mixTicks, spent);
+  bumpMax(g.mixTicksMax, spent);
+  g.active.store(active, std::memory_order_relaxed);
+}
+
+bool push(const Command& c) {
+  const uint32_t head = g.head.load(std::memory_order_relaxed);
+  if (head - g.tail.load(std::memory_order_acquire) >= kQueueSize) {
+    bump(g.dropped, 1);
+    return false;
+  }
+  g.queue[head & (kQueueSize - 1)] = c;
+  g.head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+} // namespace
+
+bool init() {
+  if (g.device) return true;
+
+  if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+    LOG_ERROR("SDL_InitSubSystem(AUDIO) failed: %s", SDL_GetError());
+    return false;
+  }
+
+  SDL_AudioSpec want{};
+  want.freq = kRequestFreq;
+  want.format = AUDIO_F32SYS;
+  want.channels = 2;
+  want.samples = kRequestFrames;
+  want.callback = callback;
+
+  // No allowed changes: SDL converts for us, so the callback always sees
+  // interleaved stereo float. Only rate/buffer size are taken from `have`.
+  SDL_AudioSpec have{};
+  g.device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
+  if (!g.device) {
+    LOG_ERROR("SDL_OpenAudioDevice failed: %s", SDL_GetError());
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    return false;
+  }
+
+  g.freq = have.freq;
+  g.bufferFrames = have.samples;
+  g.ticksToMs = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+  int loaded = 0;
+  for (int i = 0; i < kSoundCount; ++i) {
+    const std::string path = std::string("assets/sounds/") + kSoundNames[i] + ".wav";
+    if (loadWav(path, g.freq, g.samples[i])) ++loaded;
+    else g.samples[i] = synthesize((Sound)i, g.freq);
+  }
+
+  LOG_INFO("Audio: %s, %d Hz, %d-frame buffer, %d/%d sounds from assets",
+           SDL_GetCurrentAudioDriver(), g.freq, g.bufferFrames, loaded, kSoundCount);
+
+  SDL_PauseAudioDevice(g.device, 0);
+  return true;
+}
+
+void shutdown() {
+  if (!g.device) return;
+  SDL_CloseAudioDevice(g.device); // joins the callback thread
+  g.device = 0;
+  SDL_QuitSubSystem(SDL_INIT_AUDIO);
+
+  for (std::vector<float>& s : g.samples) std::vector<float>().swap(s);
+  for (Voice& v : g.voices) v = Voice{};
+  g.head.store(0);
+  g.tail.store(0);
+}
+
+bool isOpen() { return g.device != 0; }
+
+void play(Sound s, float volume, float pan) {
+  if (!g.device || s >= Sound::Count) return;
+
+  // constant-power pan
+  const float a = (std::clamp(pan, -1.0f, 1.0f) + 1.0f) * 0.25f * 3.14159265f;
+  const float v = std::clamp(volume, 0.0f, 1.0f);
+
+  Command c;
+  c.kind = Command::Play;
+  c.sound = s;
+  c.gainL = v * std::cos(a);
+  c.gainR = v * std::sin(a);
+  c.stamp = SDL_GetPerformanceCounter();
+  push(c);
+}
+
+void stopAll() {
+  if (!g.device) return;
+  Command c;
+  c.kind = Command::StopAll;
+  c.stamp = SDL_GetPerformanceCounter();
+  push(c);
+}
+
+Stats stats() {
+  Stats s;
+  s.sampleRate = g.freq;
+  s.bufferFrames = g.bufferFrames;
+  s.callbacks = g.callbacks.load(std::memory_order_relaxed);
+  s.commandsDropped = g.dropped.load(std::memory_order_relaxed);
+  s.activeVoices = g.active.load(std::memory_order_relaxed);
+
+  const uint64_t cmds = g.commands.load(std::memory_order_relaxed);
+  if (s.callbacks) {
+    s.mixUsAvg = (double)g.mixTicks.load(std::memory_order_relaxed) * g.ticksToMs * 1000.0 / (double)s.callbacks;
+  }
+  s.mixUsMax = (double)g.mixTicksMax.load(std::memory_order_relaxed) * g.ticksToMs * 1000.0;
+  if (cmds) {
+    s.queueMsAvg = (double)g.queueTicks.load(std::memory_order_relaxed) * g.ticksToMs / (double)cmds;
+  }
+  s.queueMsMax = (double)g.queueTicksMax.load(std::memory_order_relaxed) * g.ticksToMs;
+  return s;
+}
+
+void printStats() {
+  if (!g.device) {
+    std::printf("Audio: not open\n");
+    return;
+  }
+  const Stats s = stats();
+  const double bufferMs = s.sampleRate ? 1000.0 * s.bufferFrames / s.sampleRate : 0.0;
+  const double budgetUs = bufferMs * 1000.0;
+  std::printf("Audio [%s]: %llu callbacks, mix avg %.1f us / max %.1f us (%.2f%% of %.1f ms buffer), "
+              "%d voices, queue avg %.2f ms / max %.2f ms, %llu dropped\n",
+              SDL_GetCurrentAudioDriver(), (unsigned long long)s.callbacks, s.mixUsAvg, s.mixUsMax,
+              budgetUs > 0.0 ? 100.0 * s.mixUsAvg / budgetUs : 0.0, bufferMs, s.activeVoices,
+              s.queueMsAvg, s.queueMsMax, (unsigned long long)s.commandsDropped);
+}
+
+} // namespace audio
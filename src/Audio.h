@@ -0,0 +1,53 @@
+// src/Audio.h
+#pragma once
+
+#include <cstdint>
+
+// Sound effects on SDL's audio callback.
+//
+// Every sound is decoded (or synthesized) once into a float PCM cache at
+// init. The callback mixes a fixed set of voices with SIMD. The game thread
+// talks to it only through a lock-free single-producer/single-consumer
+// command queue, so play() never blocks, locks or allocates; if the queue
+// is full the command is dropped and counted.
+//
+// play() must be called from one thread (the game thread).
+namespace audio {
+
+enum class Sound : uint8_t {
+  Jump,
+  Land,
+  Duck,
+  BullStep,
+  Caught,
+  Goal,
+  Count
+};
+
+// Opens the default device (any driver, including "dummy"/"disk"). Loads
+// assets/sounds/<name>.wav where present and synthesizes the rest.
+// Returns false (and the game runs silent) if no device could be opened.
+bool init();
+void shutdown();
+bool isOpen();
+
+// volume 0..1, pan -1 (left) .. 1 (right)
+void play(Sound s, float volume = 1.0f, float pan = 0.0f);
+void stopAll();
+
+struct Stats {
+  int sampleRate = 0;
+  int bufferFrames = 0;       // device buffer (latency floor)
+  uint64_t callbacks = 0;
+  uint64_t commandsDropped = 0;
+  int activeVoices = 0;
+  double mixUsAvg = 0.0;      // CPU time per callback
+  double mixUsMax = 0.0;
+  double queueMsAvg = 0.0;    // play() -> picked up by the callback
+  double queueMsMax = 0.0;
+};
+
+Stats stats();
+void printStats();
+
+} // namespace audio
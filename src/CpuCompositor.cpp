@@ -0,0 +1,386 @@
+// src/CpuCompositor.cpp
+#include "CpuCompositor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Jobs.h"
+#include "Log.h"
+#include "TextureRegistry.h"
+#include "Trace.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define CPU_SSE2 1
+#endif
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define CPU_AVX2 1
+#endif
+
+namespace cpu {
+
+namespace {
+
+// Tiles are wide and short: rows stay contiguous for the kernels and a
+// 1080p frame still splits into enough pieces to balance across cores.
+constexpr int kTileW = 256;
+constexpr int kTileH = 64;
+
+bool gSimd = true;
+
+uint32_t premultiply(SDL_Color c) {
+  const uint32_t a = c.a;
+  const uint32_t r = (c.r * a + 127) / 255;
+  const uint32_t g = (c.g * a + 127) / 255;
+  const uint32_t b = (c.b * a + 127) / 255;
+  return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+// p * a / 255 on every channel of a packed pixel (two channels per
+// 32-bit multiply).
+inline uint32_t fade(uint32_t p, uint32_t a) {
+  uint32_t rb = (p & 0x00FF00FFu) * a + 0x00800080u;
+  uint32_t ag = ((p >> 8) & 0x00FF00FFu) * a + 0x00800080u;
+  rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+  ag = (ag + ((ag >> 8) & 0x00FF00FFu)) & 0xFF00FF00u;
+  return rb | ag;
+}
+
+// Premultiplied s over d.
+inline uint32_t over(uint32_t s, uint32_t d) { return s + fade(d, 255 - (s >> 24)); }
+
+// ---- kernels --------------------------------------------------------------
+
+void fillRow(uint32_t* d, int n, uint32_t c) {
+  int i = 0;
+  if (gSimd) {
+#ifdef CPU_AVX2
+    const __m256i v8 = _mm256_set1_epi32((int)c);
+    for (; i + 8 <= n; i += 8) _mm256_storeu_si256((__m256i*)(d + i), v8);
+#endif
+#ifdef CPU_SSE2
+    const __m128i v4 = _mm_set1_epi32((int)c);
+    for (; i + 4 <= n; i += 4) _mm_storeu_si128((__m128i*)(d + i), v4);
+#endif
+  }
+  for (; i < n; ++i) d[i] = c;
+}
+
+#ifdef CPU_SSE2
+// (x * ia + 128) / 255 per 16-bit lane, rounded like the scalar path
+inline __m128i mulDiv255(__m128i x, __m128i ia) {
+  __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, ia), _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+// 4 pixels of s over d
+inline __m128i over4(__m128i s, __m128i d) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i k255 = _mm_set1_epi16(255);
+  const __m128i sLo = _mm_unpacklo_epi8(s, zero);
+  const __m128i sHi = _mm_unpackhi_epi8(s, zero);
+  const __m128i iaLo = _mm_sub_epi16(k255, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, 0xFF), 0xFF));
+  const __m128i iaHi = _mm_sub_epi16(k255, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, 0xFF), 0xFF));
+  const __m128i lo = mulDiv255(_mm_unpacklo_epi8(d, zero), iaLo);
+  const __m128i hi = mulDiv255(_mm_unpackhi_epi8(d, zero), iaHi);
+  return _mm_add_epi8(s, _mm_packus_epi16(lo, hi));
+}
+#endif
+
+#ifdef CPU_AVX2
+inline __m256i mulDiv255x16(__m256i x, __m256i ia) {
+  __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(x, ia), _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+// 8 pixels of s over d (unpack/pack stay within 128-bit lanes, so pixel
+// order is preserved)
+inline __m256i over8(__m256i s, __m256i d) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i k255 = _mm256_set1_epi16(255);
+  const __m256i sLo = _mm256_unpacklo_epi8(s, zero);
+  const __m256i sHi = _mm256_unpackhi_epi8(s, zero);
+  const __m256i iaLo = _mm256_sub_epi16(k255, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sLo, 0xFF), 0xFF));
+  const __m256i iaHi = _mm256_sub_epi16(k255, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sHi, 0xFF), 0xFF));
+  const __m256i lo = mulDiv255x16(_mm256_unpacklo_epi8(d, zero), iaLo);
+  const __m256i hi = mulDiv255x16(_mm256_unpackhi_epi8(d, zero), iaHi);
+  return _mm256_add_epi8(s, _mm256_packus_epi16(lo, hi));
+}
+#endif
+
+// s[i] over d[i], skipping fully transparent and copying fully opaque runs.
+void overRow(uint32_t* d, const uint32_t* s, int n) {
+  int i = 0;
+  if (gSimd) {
+#ifdef CPU_AVX2
+    const __m256i alpha8 = _mm256_set1_epi32((int)0xFF000000u);
+    for (; i + 8 <= n; i += 8) {
+      const __m256i sv = _mm256_loadu_si256((const __m256i*)(s + i));
+      const __m256i a = _mm256_and_si256(sv, alpha8);
+      if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, _mm256_setzero_si256())) == -1) continue;
+      if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, alpha8)) == -1) {
+        _mm256_storeu_si256((__m256i*)(d + i), sv);
+        continue;
+      }
+      const __m256i dv = _mm256_loadu_si256((const __m256i*)(d + i));
+      _mm256_storeu_si256((__m256i*)(d + i), over8(sv, dv));
+    }
+#endif
+#ifdef CPU_SSE2
+    const __m128i alpha4 = _mm_set1_epi32((int)0xFF000000u);
+    for (; i + 4 <= n; i += 4) {
+      const __m128i sv = _mm_loadu_si128((const __m128i*)(s + i));
+      const __m128i a = _mm_and_si128(sv, alpha4);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, _mm_setzero_si128())) == 0xFFFF) continue;
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, alpha4)) == 0xFFFF) {
+        _mm_storeu_si128((__m128i*)(d + i), sv);
+        continue;
+      }
+      const __m128i dv = _mm_loadu_si128((const __m128i*)(d + i));
+      _mm_storeu_si128((__m128i*)(d + i), over4(sv, dv));
+    }
+#endif
+  }
+  for (; i < n; ++i) {
+    const uint32_t a = s[i] >> 24;
+    if (a == 255) d[i] = s[i];
+    else if (a != 0) d[i] = over(s[i], d[i]);
+  }
+}
+
+// Constant translucent color over a row.
+void blendRow(uint32_t* d, int n, uint32_t c) {
+  int i = 0;
+  if (gSimd) {
+#ifdef CPU_AVX2
+    const __m256i c8 = _mm256_set1_epi32((int)c);
+    for (; i + 8 <= n; i += 8) {
+      const __m256i dv = _mm256_loadu_si256((const __m256i*)(d + i));
+      _mm256_storeu_si256((__m256i*)(d + i), over8(c8, dv));
+    }
+#endif
+#ifdef CPU_SSE2
+    const __m128i c4 = _mm_set1_epi32((int)c);
+    for (; i + 4 <= n; i += 4) {
+      const __m128i dv = _mm_loadu_si128((const __m128i*)(d + i));
+      _mm_storeu_si128((__m128i*)(d + i), over4(c4, dv));
+    }
+#endif
+  }
+  for (; i < n; ++i) d[i] = over(c, d[i]);
+}
+
+// Pixel span [x0, x1) whose centers fall inside [a, a + len).
+inline void span(float a, float len, int& x0, int& x1) {
+  x0 = (int)std::ceil(a - 0.5f);
+  x1 = (int)std::ceil(a + len - 0.5f);
+}
+
+} // namespace
+
+void Canvas::setSimdEnabled(bool on) { gSimd = on; }
+
+bool imageFromSurface(SDL_Surface* s, Image& out) {
+  out = Image{};
+  if (!s) return false;
+
+  SDL_Surface* conv = SDL_ConvertSurfaceFormat(s, SDL_PIXELFORMAT_ARGB8888, 0);
+  if (!conv) {
+    LOG_ERROR("SDL_ConvertSurfaceFormat failed: %s", SDL_GetError());
+    return false;
+  }
+
+  out.w = conv->w;
+  out.h = conv->h;
+  out.px.resize((size_t)out.w * (size_t)out.h);
+
+  SDL_LockSurface(conv);
+  for (int y = 0; y < out.h; ++y) {
+    const Uint32* row = (const Uint32*)((const Uint8*)conv->pixels + (size_t)y * conv->pitch);
+    uint32_t* dst = &out.px[(size_t)y * out.w];
+    for (int x = 0; x < out.w; ++x) {
+      const Uint32 p = row[x];
+      dst[x] = premultiply(SDL_Color{ (Uint8)(p >> 16), (Uint8)(p >> 8), (Uint8)p, (Uint8)(p >> 24) });
+    }
+  }
+  SDL_UnlockSurface(conv);
+  SDL_FreeSurface(conv);
+  return true;
+}
+
+bool atlasFromDecoded(const DecodedSheet& decoded, Atlas& out) {
+  out = Atlas{};
+  if (!decoded.atlas || !imageFromSurface(decoded.atlas, out.image)) return false;
+  out.frames = decoded.frames;
+  return true;
+}
+
+void Canvas::resize(int w, int h) {
+  w = std::max(1, w);
+  h = std::max(1, h);
+  if (w == m_w && h == m_h) return;
+
+  m_w = w;
+  m_h = h;
+  m_px.assign((size_t)w * (size_t)h, 0xFF000000u);
+
+  const int tiles = ((w + kTileW - 1) / kTileW) * ((h + kTileH - 1) / kTileH);
+  m_scratch.assign((size_t)tiles * kTileW, 0u);
+}
+
+void Canvas::clear(SDL_Color c) {
+  c.a = 255;
+  m_cmds.clear(); // everything recorded so far would be overwritten anyway
+  Cmd cmd;
+  cmd.kind = Cmd::Fill;
+  cmd.x1 = m_w;
+  cmd.y1 = m_h;
+  cmd.color = premultiply(c);
+  m_cmds.push_back(cmd);
+}
+
+void Canvas::fill(const SDL_FRect& r, SDL_Color c) {
+  if (c.a == 0) return;
+
+  Cmd cmd;
+  span(r.x * m_scale, r.w * m_scale, cmd.x0, cmd.x1);
+  span(r.y * m_scale, r.h * m_scale, cmd.y0, cmd.y1);
+  cmd.x0 = std::max(cmd.x0, 0);
+  cmd.y0 = std::max(cmd.y0, 0);
+  cmd.x1 = std::min(cmd.x1, m_w);
+  cmd.y1 = std::min(cmd.y1, m_h);
+  if (cmd.x0 >= cmd.x1 || cmd.y0 >= cmd.y1) return;
+
+  cmd.kind = c.a == 255 ? Cmd::Fill : Cmd::Blend;
+  cmd.color = premultiply(c);
+  m_cmds.push_back(cmd);
+}
+
+void Canvas::blit(const Image& img, const SDL_Rect& src, const SDL_FRect& dst, bool flipX, uint8_t alpha) {
+  if (alpha == 0 || img.empty() || src.w <= 0 || src.h <= 0 || dst.w <= 0.0f || dst.h <= 0.0f) return;
+  if (src.x < 0 || src.y < 0 || src.x + src.w > img.w || src.y + src.h > img.h) return;
+
+  const float dx = dst.x * m_scale, dy = dst.y * m_scale;
+  const float dw = dst.w * m_scale, dh = dst.h * m_scale;
+
+  Cmd cmd;
+  cmd.kind = Cmd::Blit;
+  cmd.img = &img;
+  cmd.src = src;
+  cmd.flipX = flipX;
+  cmd.alpha = alpha;
+  span(dx, dw, cmd.x0, cmd.x1);
+  span(dy, dh, cmd.y0, cmd.y1);
+  cmd.x0 = std::max(cmd.x0, 0);
+  cmd.y0 = std::max(cmd.y0, 0);
+  cmd.x1 = std::min(cmd.x1, m_w);
+  cmd.y1 = std::min(cmd.y1, m_h);
+  if (cmd.x0 >= cmd.x1 || cmd.y0 >= cmd.y1) return;
+
+  // nearest sampling at pixel centers, in 16.16 fixed point
+  const float sx = (float)src.w / dw;
+  const float sy = (float)src.h / dh;
+  cmd.du = (int32_t)(sx * 65536.0f);
+  cmd.dv = (int32_t)(sy * 65536.0f);
+  cmd.u0 = (int32_t)(((float)cmd.x0 + 0.5f - dx) * sx * 65536.0f);
+  cmd.v0 = (int32_t)(((float)cmd.y0 + 0.5f - dy) * sy * 65536.0f);
+  m_cmds.push_back(cmd);
+}
+
+void Canvas::blitFrame(const Atlas& atlas, int frame, const SDL_FRect& cellDest, bool flipX, uint8_t alpha) {
+  if (frame < 0 || frame >= (int)atlas.frames.size()) return;
+  const SpriteFrame& f = atlas.frames[(size_t)frame];
+  if (f.empty()) return;
+
+  // same placement as SpriteSheet::place
+  const float offX = flipX ? (1.0f - f.offX - f.sizeW) : f.offX;
+  const SDL_FRect dst {
+    cellDest.x + offX * cellDest.w,
+    cellDest.y + f.offY * cellDest.h,
+    f.sizeW * cellDest.w,
+    f.sizeH * cellDest.h
+  };
+  blit(atlas.image, f.src, dst, flipX, alpha);
+}
+
+void Canvas::rasterTile(int tx0, int ty0, int tx1, int ty1, uint32_t* scratch) {
+  for (const Cmd& c : m_cmds) {
+    const int x0 = std::max(c.x0, tx0), x1 = std::min(c.x1, tx1);
+    const int y0 = std::max(c.y0, ty0), y1 = std::min(c.y1, ty1);
+    if (x0 >= x1 || y0 >= y1) continue;
+    const int n = x1 - x0;
+
+    switch (c.kind) {
+      case Cmd::Fill:
+        for (int y = y0; y < y1; ++y) fillRow(&m_px[(size_t)y * m_w + x0], n, c.color);
+        break;
+
+      case Cmd::Blend:
+        for (int y = y0; y < y1; ++y) blendRow(&m_px[(size_t)y * m_w + x0], n, c.color);
+        break;
+
+      case Cmd::Blit: {
+        const Image& img = *c.img;
+        const int64_t uStart = (int64_t)c.u0 + (int64_t)(x0 - c.x0) * c.du;
+        for (int y = y0; y < y1; ++y) {
+          const int v = std::min(c.src.h - 1, std::max(0, (int)(((int64_t)c.v0 + (int64_t)(y - c.y0) * c.dv) >> 16)));
+          const uint32_t* row = &img.px[(size_t)(c.src.y + v) * img.w + c.src.x];
+
+          int64_t u = uStart;
+          for (int k = 0; k < n; ++k, u += c.du) {
+            int sx = std::min(c.src.w - 1, std::max(0, (int)(u >> 16)));
+            if (c.flipX) sx = c.src.w - 1 - sx;
+            scratch[k] = row[sx];
+          }
+          if (c.alpha != 255) {
+            for (int k = 0; k < n; ++k) scratch[k] = fade(scratch[k], c.alpha);
+          }
+          overRow(&m_px[(size_t)y * m_w + x0], scratch, n);
+        }
+        break;
+      }
+    }
+  }
+}
+
+void Canvas::flush() {
+  if (m_cmds.empty() || m_px.empty()) return;
+  TRACE_SCOPE("cpu::Canvas::flush");
+
+  const int tilesX = (m_w + kTileW - 1) / kTileW;
+  const int tilesY = (m_h + kTileH - 1) / kTileH;
+
+  jobs::parallelFor(tilesX * tilesY, 1, [this, tilesX](int begin, int end) {
+    for (int t = begin; t < end; ++t) {
+      const int tx = (t % tilesX) * kTileW;
+      const int ty = (t / tilesX) * kTileH;
+      rasterTile(tx, ty, std::min(tx + kTileW, m_w), std::min(ty + kTileH, m_h),
+                 &m_scratch[(size_t)t * kTileW]);
+    }
+  });
+
+  m_cmds.clear();
+}
+
+bool Canvas::present(SDL_Renderer* r, SDL_Texture*& tex, const SDL_Rect* dst) {
+  if (!r || m_px.empty()) return false;
+  TRACE_SCOPE("cpu::Canvas::present");
+
+  int tw = 0, th = 0;
+  if (tex) SDL_QueryTexture(tex, nullptr, nullptr, &tw, &th);
+  if (!tex || tw != m_w || th != m_h) {
+    textures::destroy(tex);
+    tex = textures::create(r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, m_w, m_h, "cpu framebuffer");
+    if (!tex) return false;
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+  }
+
+  if (SDL_UpdateTexture(tex, nullptr, m_px.data(), m_w * (int)sizeof(uint32_t)) != 0) {
+    LOG_ERROR("SDL_UpdateTexture failed: %s", SDL_GetError());
+    return false;
+  }
+  return SDL_RenderCopy(r, tex, nullptr, dst) == 0;
+}
+
+} // namespace cpu
@@ -0,0 +1,102 @@
+// src/CpuCompositor.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+#include "SpriteSheet.h"
+
+// CPU rendering backend for machines without a usable GPU.
+//
+// Draw calls are recorded into a command list; flush() rasterizes it with
+// SIMD kernels (SSE2, AVX2 when the build targets it) into a premultiplied
+// ARGB8888 framebuffer, one tile per job so every core takes a share.
+// present() hands the frame to SDL with a single SDL_UpdateTexture.
+//
+// Sprites are nearest-sampled with premultiplied "over" blending, so
+// scaled and translucent sprites cost the same per pixel as plain copies.
+namespace cpu {
+
+// Premultiplied ARGB8888 (0xAARRGGBB) pixels.
+struct Image {
+  int w = 0;
+  int h = 0;
+  std::vector<uint32_t> px;
+
+  bool empty() const { return px.empty(); }
+};
+
+// Sheet frames (offsets as in SpriteFrame) over one premultiplied image.
+struct Atlas {
+  Image image;
+  std::vector<SpriteFrame> frames;
+
+  bool valid() const { return !image.empty() && !frames.empty(); }
+};
+
+// Copies + premultiplies any SDL surface. Returns false on failure.
+bool imageFromSurface(SDL_Surface* s, Image& out);
+
+// Keeps a CPU copy of a decoded sheet (call before uploadTrimmedSheet,
+// which consumes the surface).
+bool atlasFromDecoded(const DecodedSheet& decoded, Atlas& out);
+
+class Canvas {
+public:
+  // Framebuffer size in pixels (reallocates only when it changes).
+  void resize(int w, int h);
+  int width() const { return m_w; }
+  int height() const { return m_h; }
+  const uint32_t* pixels() const { return m_px.data(); }
+
+  // Coordinates passed to the draw calls are multiplied by this (used to
+  // draw a full-size frame into a smaller canvas for dynamic resolution).
+  void setScale(float s) { m_scale = s; }
+
+  // ---- recording (nothing touches pixels until flush) ----
+  void clear(SDL_Color c);
+  void fill(const SDL_FRect& r, SDL_Color c); // blended when c.a < 255
+  // `alpha` fades the whole sprite (like SDL_SetTextureAlphaMod).
+  void blit(const Image& img, const SDL_Rect& src, const SDL_FRect& dst,
+            bool flipX = false, uint8_t alpha = 255);
+  void blitFrame(const Atlas& atlas, int frame, const SDL_FRect& cellDest,
+                 bool flipX = false, uint8_t alpha = 255);
+
+  int commandCount() const { return (int)m_cmds.size(); }
+
+  // Rasterizes and clears the recorded commands.
+  void flush();
+
+  // Uploads the frame into `tex` (streaming, recreated when the size
+  // changes) and copies it onto the current target, stretched to `dst`
+  // (whole target when null).
+  bool present(SDL_Renderer* r, SDL_Texture*& tex, const SDL_Rect* dst = nullptr);
+
+  // Scalar kernels only (benchmarking / checking the SIMD paths).
+  static void setSimdEnabled(bool on);
+
+private:
+  struct Cmd {
+    enum Kind : uint8_t { Fill, Blend, Blit } kind = Fill;
+    bool flipX = false;
+    uint8_t alpha = 255;                 // Blit only
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0; // destination pixels, clipped, exclusive max
+    uint32_t color = 0;                  // premultiplied
+    const Image* img = nullptr;
+    SDL_Rect src{};
+    int32_t u0 = 0, du = 0;              // 16.16 source x at x0, step per pixel
+    int32_t v0 = 0, dv = 0;              // 16.16 source y at y0, step per row
+  };
+
+  void rasterTile(int tx0, int ty0, int tx1, int ty1, uint32_t* scratch);
+
+  int m_w = 0;
+  int m_h = 0;
+  float m_scale = 1.0f;
+  std::vector<uint32_t> m_px;
+  std::vector<Cmd> m_cmds;
+  std::vector<uint32_t> m_scratch; // one row of sampled pixels per tile
+};
+
+} // namespace cpu
@@ -0,0 +1,56 @@
+// src/DynamicResolution.cpp
+#include "DynamicResolution.h"
+
+#include <algorithm>
+
+static constexpr float kStepDown = 0.10f;
+static constexpr float kStepUp = 0.05f;
+static constexpr int   kCooldownFrames = 20;
+static constexpr int   kMaxProbeDelay = 60 * 30; // half a minute at 60 fps
+
+void ResolutionController::setLimits(float minScale, float maxScale) {
+  m_minScale = std::clamp(minScale, 0.1f, 1.0f);
+  m_maxScale = std::clamp(maxScale, m_minScale, 1.0f);
+  m_scale = std::clamp(m_scale, m_minScale, m_maxScale);
+}
+
+void ResolutionController::setEnabled(bool on) {
+  m_enabled = on;
+  m_cooldown = kCooldownFrames;
+  m_steadyFrames = 0;
+}
+
+void ResolutionController::addFrame(float dt) {
+  if (!m_enabled || dt <= 0.0f) return;
+
+  // Ignore single huge stalls (window drag, scene load): they say nothing
+  // about fill-rate.
+  const float ms = std::min(dt * 1000.0f, m_targetMs * 4.0f);
+  m_avgMs += (ms - m_avgMs) * 0.1f;
+
+  if (m_cooldown > 0) {
+    --m_cooldown;
+    return;
+  }
+
+  // Missing the budget (e.g. dropping from 60 to 30 with vsync): step down.
+  if (m_avgMs > m_targetMs * 1.15f) {
+    if (m_scale > m_minScale) {
+      m_scale = std::max(m_minScale, m_scale - kStepDown);
+      m_cooldown = kCooldownFrames;
+    }
+    // A failed probe means the previous level was the sustainable one.
+    if (m_probing) m_probeDelay = std::min(kMaxProbeDelay, m_probeDelay * 2);
+    m_probing = false;
+    m_steadyFrames = 0;
+    return;
+  }
+
+  // Within budget: after a steady stretch, try a little more resolution.
+  if (++m_steadyFrames >= m_probeDelay && m_scale < m_maxScale) {
+    m_scale = std::min(m_maxScale, m_scale + kStepUp);
+    m_cooldown = kCooldownFrames;
+    m_steadyFrames = 0;
+    m_probing = true;
+  }
+}
@@ -0,0 +1,32 @@
+// src/DynamicResolution.h
+#pragma once
+
+// Chooses the internal render scale for the world pass from measured
+// frame intervals. Drops resolution quickly when frames miss the budget,
+// and probes back up slowly once they are steady, backing off further
+// after each probe that fails.
+class ResolutionController {
+public:
+  void setTargetFrameMs(float ms) { m_targetMs = ms; }
+  void setLimits(float minScale, float maxScale);
+  void setEnabled(bool on);
+
+  bool enabled() const { return m_enabled; }
+  float scale() const { return m_enabled ? m_scale : 1.0f; }
+
+  // Feed the duration of the last frame (seconds).
+  void addFrame(float dt);
+
+private:
+  bool  m_enabled = true;
+  float m_targetMs = 1000.0f / 60.0f; // until setTargetFrameMs (display refresh)
+  float m_minScale = 0.5f;
+  float m_maxScale = 1.0f;
+
+  float m_scale = 1.0f;
+  float m_avgMs = 1000.0f / 60.0f; // exponential moving average
+  int   m_cooldown = 0;            // frames before the next change
+  int   m_steadyFrames = 0;        // consecutive frames within budget
+  int   m_probeDelay = 120;        // steady frames required to step up
+  bool  m_probing = false;         // last change was a step up
+};
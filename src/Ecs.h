@@ -0,0 +1,165 @@
+// src/Ecs.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Minimal sparse-set entity/component storage.
+// Every component type gets its own pool; components are kept packed in a
+// contiguous array, so systems walk plain vectors instead of chasing
+// per-entity pointers.
+namespace ecs {
+
+// Entity handle: low 32 bits = slot index, high 32 bits = generation, so a
+// slot recycled every frame still takes years to hand out a stale match.
+using Entity = std::uint64_t;
+constexpr Entity kNullEntity = 0xFFFFFFFFFFFFFFFFull;
+
+inline std::uint32_t entityIndex(Entity e) { return (std::uint32_t)e; }
+inline std::uint32_t entityGeneration(Entity e) { return (std::uint32_t)(e >> 32); }
+
+template <typename T>
+class SparseSet {
+public:
+  bool has(Entity e) const {
+    const std::uint32_t i = entityIndex(e);
+    return i < m_sparse.size() && m_sparse[i] != kNone && m_dense[m_sparse[i]] == e;
+  }
+
+  T& get(Entity e) { return m_data[m_sparse[entityIndex(e)]]; }
+  const T& get(Entity e) const { return m_data[m_sparse[entityIndex(e)]]; }
+
+  T* tryGet(Entity e) { return has(e) ? &get(e) : nullptr; }
+
+  T& add(Entity e, const T& value) {
+    if (has(e)) {
+      T& slot = get(e);
+      slot = value;
+      return slot;
+    }
+
+    const std::uint32_t i = entityIndex(e);
+    if (i >= m_sparse.size()) m_sparse.resize(i + 1, kNone);
+    m_sparse[i] = (std::uint32_t)m_dense.size();
+    m_dense.push_back(e);
+    m_data.push_back(value);
+    return m_data.back();
+  }
+
+  // Swap-remove keeps the packed arrays hole-free.
+  void remove(Entity e) {
+    if (!has(e)) return;
+
+    const std::uint32_t i = entityIndex(e);
+    const std::uint32_t at = m_sparse[i];
+    const std::uint32_t last = (std::uint32_t)m_dense.size() - 1;
+
+    if (at != last) {
+      m_dense[at] = m_dense[last];
+      m_data[at] = std::move(m_data[last]);
+      m_sparse[entityIndex(m_dense[at])] = at;
+    }
+
+    m_dense.pop_back();
+    m_data.pop_back();
+    m_sparse[i] = kNone;
+  }
+
+  void clear() {
+    m_sparse.clear();
+    m_dense.clear();
+    m_data.clear();
+  }
+
+  void reserve(std::size_t n) {
+    m_dense.reserve(n);
+    m_data.reserve(n);
+  }
+
+  std::size_t size() const { return m_dense.size(); }
+
+  // Packed arrays (same order): entities()[i] owns components()[i].
+  const std::vector<Entity>& entities() const { return m_dense; }
+  std::vector<T>& components() { return m_data; }
+  const std::vector<T>& components() const { return m_data; }
+
+private:
+  static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+  std::vector<std::uint32_t> m_sparse;
+  std::vector<Entity> m_dense;
+  std::vector<T> m_data;
+};
+
+// Registry over a fixed, compile-time list of component types.
+template <typename... Components>
+class Registry {
+public:
+  Entity create() {
+    std::uint32_t index = 0;
+    if (!m_free.empty()) {
+      index = m_free.back();
+      m_free.pop_back();
+    } else {
+      index = (std::uint32_t)m_generations.size();
+      m_generations.push_back(0);
+    }
+    return ((Entity)m_generations[index] << 32) | index;
+  }
+
+  void destroy(Entity e) {
+    if (!alive(e)) return;
+    (pool<Components>().remove(e), ...);
+
+    const std::uint32_t index = entityIndex(e);
+    ++m_generations[index]; // stale handles stop matching
+    m_free.push_back(index);
+  }
+
+  bool alive(Entity e) const {
+    const std::uint32_t index = entityIndex(e);
+    return e != kNullEntity && index < m_generations.size() &&
+           m_generations[index] == entityGeneration(e);
+  }
+
+  void clear() {
+    (pool<Components>().clear(), ...);
+    m_generations.clear();
+    m_free.clear();
+  }
+
+  template <typename T> SparseSet<T>& pool() { return std::get<SparseSet<T>>(m_pools); }
+  template <typename T> const SparseSet<T>& pool() const { return std::get<SparseSet<T>>(m_pools); }
+
+  template <typename T> T& add(Entity e, const T& value = T{}) { return pool<T>().add(e, value); }
+  template <typename T> void remove(Entity e) { pool<T>().remove(e); }
+  template <typename T> bool has(Entity e) const { return pool<T>().has(e); }
+  template <typename T> T& get(Entity e) { return pool<T>().get(e); }
+  template <typename T> const T& get(Entity e) const { return pool<T>().get(e); }
+  template <typename T> T* tryGet(Entity e) { return pool<T>().tryGet(e); }
+
+  // Calls fn(entity, First&, Rest&...) for every entity owning all listed
+  // components. Iteration is driven by First's packed array, so list the
+  // rarest component first. Do not add/remove First while iterating.
+  template <typename First, typename... Rest, typename Fn>
+  void each(Fn&& fn) {
+    SparseSet<First>& lead = pool<First>();
+    const std::vector<Entity>& ents = lead.entities();
+    std::vector<First>& comps = lead.components();
+
+    for (std::size_t i = 0; i < ents.size(); ++i) {
+      const Entity e = ents[i];
+      if ((pool<Rest>().has(e) && ...)) fn(e, comps[i], pool<Rest>().get(e)...);
+    }
+  }
+
+private:
+  std::vector<std::uint32_t> m_generations;
+  std::vector<std::uint32_t> m_free;
+  std::tuple<SparseSet<Components>...> m_pools;
+};
+
+} // namespace ecs
@@ -0,0 +1,72 @@
+// src/EcsWorld.cpp
+#include "EcsWorld.h"
+
+#include "Physics.h"
+
+namespace ecs {
+
+using physics::overlaps;
+
+void runChasers(World& w) {
+  w.each<Chaser, Velocity>([](Entity, Chaser& c, Velocity& v) {
+    v.vx = c.speed;
+  });
+}
+
+void applyGravity(World& w, float gravity, float dt) {
+  w.each<Body, Velocity>([gravity, dt](Entity, Body& b, Velocity& v) {
+    v.vy += gravity * b.gravityScale * dt;
+  });
+}
+
+void integrateMotion(World& w, float dt) {
+  w.each<Velocity, Transform>([dt](Entity, Velocity& v, Transform& t) {
+    t.rect.x += v.vx * dt;
+    t.rect.y += v.vy * dt;
+  });
+}
+
+void collideWithLevel(World& w, float groundY, const std::vector<Obstacle>& obstacles) {
+  w.each<Body, Transform, Velocity>([&](Entity, Body& b, Transform& t, Velocity& v) {
+    b.onGround = false;
+
+    if (b.collidesWithObstacles && v.vy > 0.0f) {
+      for (const auto& o : obstacles) {
+        if (o.type != ObstacleType::JumpOver) continue;
+        if (!overlaps(t.rect, o.rect)) continue;
+
+        // only land when the feet are near the top (no side pushes)
+        const float bottom = t.rect.y + t.rect.h;
+        if (bottom - o.rect.y <= o.rect.h * 0.5f) {
+          t.rect.y = o.rect.y - t.rect.h;
+          v.vy = 0.0f;
+          b.onGround = true;
+        }
+      }
+    }
+
+    const float floorY = groundY - t.rect.h;
+    if (t.rect.y >= floorY) {
+      t.rect.y = floorY;
+      v.vy = 0.0f;
+      b.onGround = true;
+    }
+  });
+}
+
+void advanceSprites(World& w, float dt) {
+  std::vector<Sprite>& sprites = w.pool<Sprite>().components();
+  if (sprites.empty()) return;
+  anim::advance(&sprites[0].anim, sizeof(Sprite), (int)sprites.size(), dt);
+}
+
+Entity findCatchingChaser(World& w, const SDL_FRect& target, float reach) {
+  Entity hit = kNullEntity;
+  w.each<Chaser, Transform>([&](Entity e, Chaser&, Transform& t) {
+    if (hit != kNullEntity) return;
+    if (overlaps(t.rect, target) || (t.rect.x + t.rect.w) >= (target.x + reach)) hit = e;
+  });
+  return hit;
+}
+
+} // namespace ecs
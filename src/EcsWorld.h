@@ -0,0 +1,57 @@
+// src/EcsWorld.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "Animation.h"
+#include "Ecs.h"
+#include "Level.h"
+
+// Gameplay components + systems for dynamic entities (bull herd, and
+// anything else that moves on its own). The player keeps its hand-tuned
+// controller in GameScene.
+namespace ecs {
+
+struct Transform {
+  SDL_FRect rect{};
+};
+
+struct Velocity {
+  float vx = 0.0f;
+  float vy = 0.0f;
+};
+
+// Affected by gravity and the level floor.
+struct Body {
+  float gravityScale = 1.0f;
+  bool onGround = false;
+  bool collidesWithObstacles = false; // land on top of JumpOver blocks
+};
+
+// Runs right at a constant speed; touching the player restarts the level.
+struct Chaser {
+  float speed = 0.0f;
+};
+
+// Which sheet (an index into the scene's sprite-kind table, one kind per
+// .anim file), and clip/time within that sheet's anim::AnimSet.
+struct Sprite {
+  uint16_t sheet = 0;
+  anim::Playback anim;
+};
+
+using World = Registry<Transform, Velocity, Body, Chaser, Sprite>;
+
+// ---- systems (each walks one packed component array) ----
+void runChasers(World& w);
+void applyGravity(World& w, float gravity, float dt);
+void integrateMotion(World& w, float dt);
+void collideWithLevel(World& w, float groundY, const std::vector<Obstacle>& obstacles);
+void advanceSprites(World& w, float dt);
+
+// First chaser that caught `target` (touching it, or its front edge got
+// within `reach` of target's left side), or kNullEntity.
+Entity findCatchingChaser(World& w, const SDL_FRect& target, float reach);
+
+} // namespace ecs
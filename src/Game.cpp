@@ -1,13 +1,21 @@
 // src/Game.cpp
 #include "Game.h"
 
-#include <cstdio>
+#include <algorithm>
 #include <utility>
 
+#include "Audio.h"
+#include "Log.h"
 #include "Scene.h"
 #include "MenuScene.h"
 #include "OptionsScene.h"
 #include "GameScene.h"
+#include "RendererProbe.h"
+#include "Startup.h"
+#include "Telemetry.h"
+#include "Text.h"
+#include "TextureRegistry.h"
+#include "Trace.h"
 
 #ifdef __EMSCRIPTEN__
   #include <emscripten.h>
@@ -15,11 +23,19 @@
 
 Game::Game(SDL_Window* window, SDL_Renderer* renderer, TTF_Font* font)
   : m_window(window), m_renderer(renderer), m_font(font) {
+  m_input.setTargets(m_window, m_renderer);
   setScene(SceneId::Menu);
 }
 
 Game::~Game() {
+  // a font load still in flight writes into this object
+  jobs::wait(m_fontJob);
+  clearTextCache(); // before the fonts and renderer it was drawn with go
+  if (m_loadedFont && m_loadedFont != m_ownedFont) TTF_CloseFont(m_loadedFont);
+  if (m_ownedFont) TTF_CloseFont(m_ownedFont);
+
   if (m_renderer) {
+    textures::forgetRenderer(m_renderer);
     SDL_DestroyRenderer(m_renderer);
     m_renderer = nullptr;
   }
@@ -33,8 +49,7 @@ void Game::requestScene(SceneId next) {
 }
 
 void Game::getRenderSize(int& w, int& h) const {
-  w = 0; h = 0;
-  if (m_renderer) SDL_GetRendererOutputSize(m_renderer, &w, &h);
+  m_input.viewportSize(w, h);
 }
 
 std::unique_ptr<Scene> Game::makeScene(SceneId id) {
@@ -47,7 +62,9 @@ std::unique_ptr<Scene> Game::makeScene(SceneId id) {
 }
 
 void Game::setScene(SceneId id) {
+  telemetry::record(telemetry::Event::SceneChange, telemetry::kNoLevel, 0.0f, (uint32_t)m_currentId, (uint32_t)id);
   m_currentId = id;
+  m_input.reset();
   m_scene = makeScene(id);
 
   // If the renderer was recreated before this scene was constructed,
@@ -69,7 +86,7 @@ void Game::toggleFullscreen() {
 
   Uint32 flags = m_isFullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0;
   if (SDL_SetWindowFullscreen(m_window, flags) != 0) {
-    std::printf("SDL_SetWindowFullscreen failed: %s\n", SDL_GetError());
+    LOG_ERROR("SDL_SetWindowFullscreen failed: %s", SDL_GetError());
     m_isFullscreen = !m_isFullscreen;
     return;
   }
@@ -97,6 +114,7 @@ void Game::setWindowedResolution(int w, int h) {
 
 void Game::applyDisplayChanges() {
   if (!m_rendererDirty) return;
+  TRACE_SCOPE("Game::applyDisplayChanges");
   m_rendererDirty = false;
 
   if (!m_window) return;
@@ -106,20 +124,25 @@ void Game::applyDisplayChanges() {
   return;
 #else
   if (m_renderer) {
+    clearTextCache();
+    textures::forgetRenderer(m_renderer); // SDL frees its textures
     SDL_DestroyRenderer(m_renderer);
     m_renderer = nullptr;
   }
 
-  m_renderer = SDL_CreateRenderer(
-    m_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
-  );
+  m_renderer = renderprobe::createRenderer(m_window); // same driver as startup
+  m_input.setTargets(m_window, m_renderer);
 
   if (!m_renderer) {
-    std::printf("SDL_CreateRenderer failed after display change: %s\n", SDL_GetError());
+    LOG_ERROR("SDL_CreateRenderer failed after display change: %s", SDL_GetError());
     requestQuit();
     return;
   }
 
+  int w = 0, h = 0;
+  getRenderSize(w, h);
+  telemetry::record(telemetry::Event::RendererRebuild, telemetry::kNoLevel, 0.0f, (uint32_t)w, (uint32_t)h);
+
   // IMPORTANT: notify active scene so it can reload textures
   if (m_scene) m_scene->onRendererChanged(m_renderer);
 #endif
@@ -128,6 +151,23 @@ void Game::applyDisplayChanges() {
 // --------------------------------------------------
 
 void Game::handleEvent(const SDL_Event& e) {
+  TRACE_SCOPE("Game::handleEvent");
+  m_framePending = true;
+
+  if (e.type == SDL_WINDOWEVENT) {
+    switch (e.window.event) {
+      case SDL_WINDOWEVENT_MINIMIZED:
+      case SDL_WINDOWEVENT_HIDDEN:       m_minimized = true; break;
+      case SDL_WINDOWEVENT_RESTORED:
+      case SDL_WINDOWEVENT_MAXIMIZED:
+      case SDL_WINDOWEVENT_SHOWN:        m_minimized = false; break;
+      case SDL_WINDOWEVENT_FOCUS_LOST:   m_focused = false; break;
+      case SDL_WINDOWEVENT_FOCUS_GAINED: m_focused = true; break;
+      case SDL_WINDOWEVENT_EXPOSED:      m_exposed = true; break;
+      default: break;
+    }
+  }
+
   if (e.type == SDL_QUIT) {
     requestQuit();
     return;
@@ -139,6 +179,25 @@ void Game::handleEvent(const SDL_Event& e) {
     return;
   }
 
+  // F9: dump the recorded timeline (no-op unless built with GAME_TRACE)
+  if (e.type == SDL_KEYDOWN && e.key.repeat == 0 && e.key.keysym.sym == SDLK_F9) {
+    if (trace::writeChromeJson("trace.json")) LOG_INFO("Wrote trace.json");
+    return;
+  }
+
+  // F10: texture memory report
+  if (e.type == SDL_KEYDOWN && e.key.repeat == 0 && e.key.keysym.sym == SDLK_F10) {
+    textures::printReport();
+    return;
+  }
+
+  // F11: audio latency / mixer cost
+  if (e.type == SDL_KEYDOWN && e.key.repeat == 0 && e.key.keysym.sym == SDLK_F11) {
+    audio::printStats();
+    return;
+  }
+
+  if (m_input.feed(e, m_scene.get())) return;
   if (m_scene) m_scene->handleEvent(e);
 }
 
@@ -159,19 +218,122 @@ bool Game::isRunning() const {
   return m_running;
 }
 
+void Game::stepFrame(float dt) {
+  // before the scene change / renderer rebuild below can consume it
+  if (m_hitch.enabled()) m_hitch.setBefore(hitchContext());
+
+  applyDisplayChanges();
+  m_hitch.mark(hitch::Display);
+  if (!m_running || !m_renderer) return;
+
+  telemetry::beginFrame();
+  m_input.flush(m_scene.get()); // this frame's coalesced pointer motion
+  update(dt);
+  m_hitch.mark(hitch::Update);
+  render();
+  m_hitch.mark(hitch::Render);
+}
+
+void Game::setFont(TTF_Font* font) { m_font = font; }
+
+void Game::loadFontAsync(const char* path, int ptSize) {
+  if (!path || m_fontRequested) return;
+  m_fontPath = path;
+  m_fontSize = ptSize;
+  m_fontRequested = true;
+}
+
+// Runs after each presented frame: the first call starts the load (so it
+// never delays the first frame), later calls pick up the result.
+void Game::pollFontLoad() {
+  if (!m_fontRequested) return;
+
+  if (!m_fontLoading) {
+    m_fontLoading = true;
+    jobs::run([this] {
+      TRACE_SCOPE("TTF_OpenFont");
+      m_loadedFont = TTF_OpenFont(m_fontPath.c_str(), m_fontSize);
+      if (!m_loadedFont) m_fontError = TTF_GetError();
+    }, &m_fontJob);
+  }
+  if (!m_fontJob.done()) return;
+
+  m_fontRequested = false;
+  m_fontLoading = false;
+  if (!m_loadedFont) {
+    LOG_ERROR("TTF_OpenFont failed (%s): %s", m_fontPath.c_str(), m_fontError.c_str());
+  } else {
+    m_ownedFont = m_loadedFont;
+    m_loadedFont = nullptr;
+    setFont(m_ownedFont);
+    m_framePending = true; // static scenes still need a frame with text
+  }
+
+  startup::mark("font");
+  startup::report();
+}
+
+// Idle pacing: how long run() sleeps per wait when nothing needs drawing
+// (events wake it immediately), and the dt used for the first frame after
+// an idle stretch so the simulation doesn't jump.
+static constexpr Uint32 IDLE_WAIT_MS = 500;
+static constexpr float  RESUME_DT = 1.0f / 60.0f;
+
+bool Game::wantsFrame() const {
+  if (m_minimized) return false;
+  // Unfocused windows stay visible: repaint what the system asks for and
+  // keep presenting until the font load (started after a frame) is done.
+  if (!m_focused) return m_exposed || m_fontRequested;
+  return m_framePending || m_hasPendingSceneChange || m_rendererDirty ||
+         m_fontRequested || !m_scene || m_scene->needsRedraw();
+}
+
+float Game::nextFrameDt() {
+  const Uint64 now = SDL_GetPerformanceCounter();
+  if (m_prevCounter == 0) m_prevCounter = now;
+  float dt = (float)((now - m_prevCounter) / (double)SDL_GetPerformanceFrequency());
+  m_prevCounter = now;
+
+  if (m_resumeFromIdle) {
+    m_resumeFromIdle = false;
+    dt = std::min(dt, RESUME_DT);
+  }
+  return dt;
+}
+
+static const char* sceneName(Game::SceneId id) {
+  switch (id) {
+    case Game::SceneId::Menu:    return "Menu";
+    case Game::SceneId::Play:    return "Play";
+    case Game::SceneId::Options: return "Options";
+    default:                     return "?";
+  }
+}
+
+hitch::Context Game::hitchContext() const {
+  hitch::Context c;
+  c.scene = sceneName(m_currentId);
+  c.pendingScene = m_hasPendingSceneChange ? sceneName(m_pendingId) : nullptr;
+  c.rendererDirty = m_rendererDirty;
+  c.obstacles = m_scene ? m_scene->obstacleCount() : 0;
+
+  const textures::Stats t = textures::stats();
+  c.textures = t.count;
+  c.textureBytes = t.liveBytes;
+  return c;
+}
+
 // One frame (Emscripten-safe)
 void Game::tick() {
+  TRACE_SCOPE("Game::tick");
+
   if (!m_renderer) {
-    std::printf("Game::tick(): renderer is null\n");
+    LOG_ERROR("Game::tick(): renderer is null");
     requestQuit();
     return;
   }
 
-  static Uint64 prev = SDL_GetPerformanceCounter();
-  Uint64 now = SDL_GetPerformanceCounter();
-  const double freq = (double)SDL_GetPerformanceFrequency();
-  float dt = (float)((now - prev) / freq);
-  prev = now;
+  m_hitch.beginFrame();
 
   SDL_Event e{};
   while (SDL_PollEvent(&e)) {
@@ -180,47 +342,66 @@ void Game::tick() {
   }
   if (!m_running) return;
 
-  applyDisplayChanges();
-  if (!m_running || !m_renderer) return;
+  // idle: keep the last frame on the canvas (main.cpp slows the loop)
+  if (!wantsFrame()) {
+    m_resumeFromIdle = true;
+    return;
+  }
+  m_hitch.mark(hitch::Events);
 
-  update(dt);
-  render();
+  stepFrame(nextFrameDt());
+  if (!m_running || !m_renderer) return;
 
   SDL_RenderPresent(m_renderer);
+  m_hitch.mark(hitch::Present);
+  m_framePending = false;
+  m_exposed = false;
+  pollFontLoad();
+  m_hitch.mark(hitch::Post);
+  m_hitch.endFrame(hitchContext());
 }
 
 void Game::run() {
 #ifndef __EMSCRIPTEN__
   if (!m_renderer) {
-    std::printf("Game::run(): renderer is null\n");
+    LOG_ERROR("Game::run(): renderer is null");
     return;
   }
 
-  Uint64 prev = SDL_GetPerformanceCounter();
-  const double freq = (double)SDL_GetPerformanceFrequency();
   SDL_Event e{};
 
   while (m_running) {
-    Uint64 now = SDL_GetPerformanceCounter();
-    float dt = (float)((now - prev) / freq);
-    prev = now;
+    // Nothing to draw: sleep in the event queue instead of spinning on vsync.
+    if (!wantsFrame()) {
+      m_resumeFromIdle = true;
+      if (SDL_WaitEventTimeout(&e, IDLE_WAIT_MS)) handleEvent(e);
+      continue;
+    }
+
+    TRACE_SCOPE("Game::run frame");
+    m_hitch.beginFrame();
+    const float dt = nextFrameDt();
 
     while (SDL_PollEvent(&e)) {
       handleEvent(e);
       if (!m_running) break;
     }
     if (!m_running) break;
+    m_hitch.mark(hitch::Events);
 
-    applyDisplayChanges();
+    stepFrame(dt);
     if (!m_running || !m_renderer) break;
 
-    update(dt);
-    render();
-
     SDL_RenderPresent(m_renderer);
+    m_hitch.mark(hitch::Present);
+    m_framePending = false;
+    m_exposed = false;
+    pollFontLoad();
+    m_hitch.mark(hitch::Post);
+    m_hitch.endFrame(hitchContext());
   }
 #else
   // In web builds, main.cpp drives tick() using emscripten_set_main_loop()
-  std::printf("Game::run() is not used in Emscripten builds.\n");
+  LOG_ERROR("Game::run() is not used in Emscripten builds.");
 #endif
 }
@@ -4,6 +4,11 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <memory>
+#include <string>
+
+#include "Hitch.h"
+#include "Input.h"
+#include "Jobs.h"
 
 // Forward declarations
 class Scene;
@@ -23,12 +28,42 @@ public:
 
   bool isRunning() const;
 
+  // True while nothing needs drawing (static scene, no input since the last
+  // frame) or the window is minimized / unfocused; an unfocused window still
+  // repaints when exposed and until the font has loaded. run() blocks on
+  // events then; the web loop uses this to lower its main-loop rate.
+  bool isIdle() const { return !wantsFrame(); }
+
+  // Scripted driving (tools/FrameRegress): one update+render with a fixed
+  // dt and no event polling / present, and direct event injection.
+  void stepFrame(float dt);
+  void injectEvent(const SDL_Event& e) { handleEvent(e); }
+
+  // Seeds generated level layouts; 0 = the built-in campaign (default)
+  void setRandomSeed(unsigned seed) { m_randomSeed = seed; }
+  unsigned randomSeed() const { return m_randomSeed; }
+
+  // Ghost runs are read from / saved to the pref dir; off keeps scripted
+  // runs independent of local play history.
+  void setGhostsEnabled(bool on) { m_ghostsEnabled = on; }
+  bool ghostsEnabled() const { return m_ghostsEnabled; }
+
+  // Authored layouts are read from assets/levels; off always generates
+  // them from the seed (and disables hot reload).
+  void setLevelFilesEnabled(bool on) { m_levelFilesEnabled = on; }
+  bool levelFilesEnabled() const { return m_levelFilesEnabled; }
+
   void requestQuit();
   void requestScene(SceneId next);
 
   SDL_Renderer* renderer() const { return m_renderer; }
-  TTF_Font* font() const { return m_font; }
-  void getRenderSize(int& w, int& h) const;
+  TTF_Font* font() const { return m_font; } // null until loaded (draw text conditionally)
+
+  // Staged startup: the font is opened after the first presented frame, on
+  // a worker thread where available. Game owns (and closes) that font.
+  void loadFontAsync(const char* path, int ptSize);
+  void setFont(TTF_Font* font); // not owned
+  void getRenderSize(int& w, int& h) const; // cached; refreshed on resize
 
   // Window access for display settings
   SDL_Window* window() const { return m_window; }
@@ -47,23 +82,53 @@ private:
   void update(float dt);
   void render();
 
+  void pollFontLoad();
+
+  bool wantsFrame() const;
+  float nextFrameDt();
+  hitch::Context hitchContext() const;
+
   void setScene(SceneId id);
   std::unique_ptr<Scene> makeScene(SceneId id);
 
 private:
   SDL_Window*   m_window   = nullptr; // not owned (created/destroyed in main)
   SDL_Renderer* m_renderer = nullptr; // owned by Game if it recreates it
-  TTF_Font*     m_font     = nullptr; // not owned
+  TTF_Font*     m_font     = nullptr; // owned only if it is m_ownedFont
+
+  // async font load (see loadFontAsync)
+  TTF_Font*     m_ownedFont = nullptr;
+  TTF_Font*     m_loadedFont = nullptr; // written by the load job
+  std::string   m_fontError;            // ditto (SDL errors are per thread)
+  std::string   m_fontPath;
+  int           m_fontSize = 0;
+  bool          m_fontRequested = false;
+  bool          m_fontLoading = false;
+  jobs::Counter m_fontJob;
 
   bool m_running = true;
 
+  // idle / low-power (see isIdle)
+  bool   m_framePending = true;  // an event arrived since the last present
+  bool   m_minimized = false;
+  bool   m_focused = true;
+  bool   m_exposed = false;      // window needs a repaint (even unfocused)
+  bool   m_resumeFromIdle = false;
+  Uint64 m_prevCounter = 0;
+
   SceneId m_currentId = SceneId::Menu;
   SceneId m_pendingId = SceneId::Menu;
   bool    m_hasPendingSceneChange = false;
 
   std::unique_ptr<Scene> m_scene;
+  input::Router m_input;
+  hitch::Detector m_hitch; // slow-frame reports (tick/run frames only)
 
   // Display state
   bool m_isFullscreen = false;
   bool m_rendererDirty = false;
+
+  unsigned m_randomSeed = 0;
+  bool     m_ghostsEnabled = true;
+  bool     m_levelFilesEnabled = true;
 };
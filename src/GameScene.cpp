@@ -7,89 +7,59 @@
 
 #include "GameScene.h"
 
+#include <SDL2/SDL_image.h>
 #include <algorithm>
 #include <cstdlib>
-#include <ctime>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <cmath>
 
-#include <SDL2/SDL_image.h>
-
+#include "Audio.h"
 #include "Game.h"
+#include "Jobs.h"
+#include "LevelFile.h"
+#include "LevelGen.h"
+#include "LevelValidator.h"
+#include "Log.h"
+#include "Physics.h"
+#include "Telemetry.h"
 #include "Text.h" // drawTextCentered()
-
-// ===================== YOUR SHEET LAYOUTS =====================
-// bull_sheet.png: 2 rows x 4 columns (8 frames total)
-static constexpr int BULL_COLS = 4;
-static constexpr int BULL_ROWS = 2;
-static constexpr float BULL_RUN_FPS = 10.0f;
-
-// player_sheet.png:
-// Row 0: 5 run frames
-// Row 1: col0 jump, col1 duck
-static constexpr int PLAYER_RUN_COLS = 5;
-static constexpr int PLAYER_ROWS     = 2;
-static constexpr int PLAYER_ROW_RUN  = 0;
-static constexpr int PLAYER_ROW_MISC = 1;
-static constexpr int PLAYER_COL_JUMP = 0;
-static constexpr int PLAYER_COL_DUCK = 1;
-static constexpr float PLAYER_RUN_FPS = 12.0f;
-// =============================================================
-
-static float frand01() { return (float)std::rand() / (float)RAND_MAX; }
-
-static bool AABB(const SDL_FRect& a, const SDL_FRect& b) {
-  return !(a.x + a.w <= b.x || b.x + b.w <= a.x ||
-           a.y + a.h <= b.y || b.y + b.h <= a.y);
-}
-
-// Solid rules:
-// - JumpOver blocks always.
-// - DuckUnder blocks only when NOT ducking.
-static bool isSolidForPlayer(const Obstacle& o, bool ducking) {
-  if (o.type == ObstacleType::JumpOver) return true;
-  if (o.type == ObstacleType::DuckUnder) return !ducking;
-  return true;
+#include "TextureRegistry.h"
+#include "Trace.h"
+#include "Zoom.h"
+
+// Sheet layouts and clips live in the .anim files next to the images.
+static constexpr const char* PLAYER_ANIM = "assets/sprites/player_sheet.anim";
+static constexpr const char* BULL_ANIM = "assets/sprites/bull_sheet.anim";
+
+// Ghost sprite opacity (both render paths).
+static constexpr Uint8 GHOST_ALPHA = 110;
+
+// GAME_CPU_RENDER=0/1 forces the CPU compositor; otherwise it is used
+// whenever SDL fell back to its software renderer.
+static bool wantCpuCompositing(SDL_Renderer* r) {
+  if (const char* env = std::getenv("GAME_CPU_RENDER")) return std::atoi(env) != 0;
+  SDL_RendererInfo info{};
+  return r && SDL_GetRendererInfo(r, &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE) != 0;
 }
 
-static SDL_Texture* loadTexture(SDL_Renderer* r, const char* path) {
-  if (!r || !path) return nullptr;
-  SDL_Surface* surf = IMG_Load(path);
-  if (!surf) {
-    std::printf("IMG_Load failed (%s): %s\n", path, IMG_GetError());
-    return nullptr;
-  }
-  SDL_Texture* tex = SDL_CreateTextureFromSurface(r, surf);
-  SDL_FreeSurface(surf);
-  if (!tex) std::printf("SDL_CreateTextureFromSurface failed (%s): %s\n", path, SDL_GetError());
-  return tex;
+// n-th layout candidate for a level (murmur3 finalizer; never 0).
+static uint32_t candidateSeed(uint32_t campaign, int level, uint32_t n) {
+  uint32_t h = campaign ^ ((uint32_t)level * 0x9E3779B9u) ^ (n * 0x85EBCA6Bu);
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  h *= 0x846CA68Bu;
+  h ^= h >> 16;
+  return h | 1u;
 }
 
-static void destroyTex(SDL_Texture*& t) {
-  if (t) { SDL_DestroyTexture(t); t = nullptr; }
-}
-
-// -----------------------------
-// Touch + mouse helpers
-// -----------------------------
-static void getInputPosPixels(const SDL_Event& e, int rw, int rh, float& outX, float& outY) {
-  if (e.type == SDL_FINGERDOWN || e.type == SDL_FINGERMOTION || e.type == SDL_FINGERUP) {
-    outX = e.tfinger.x * (float)rw; // tfinger is normalized 0..1
-    outY = e.tfinger.y * (float)rh;
-    return;
-  }
-  if (e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP) {
-    outX = (float)e.button.x;
-    outY = (float)e.button.y;
-    return;
-  }
-  if (e.type == SDL_MOUSEMOTION) {
-    outX = (float)e.motion.x;
-    outY = (float)e.motion.y;
-    return;
-  }
-  outX = 0.0f; outY = 0.0f;
+// Authored layouts override the generated ones when present.
+static std::string levelFilePathFor(int idx) {
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "assets/levels/level%02d.blvl", idx + 1);
+  return buf;
 }
 
 static void clearTouchHeld(bool& rightHeld, bool& duckHeld,
@@ -99,78 +69,81 @@ static void clearTouchHeld(bool& rightHeld, bool& duckHeld,
 }
 
 GameScene::GameScene(Game* game) : m_game(game) {
-  std::srand((unsigned)std::time(nullptr));
+  static constexpr uint32_t kCampaignSeed = 0xB011C0DEu;
+  campaignSeed = (m_game && m_game->randomSeed()) ? (uint32_t)m_game->randomSeed() : kCampaignSeed;
   buildLevels();
 
   // Player collider (no face)
-  player.w = 44.0f;
-  player.h = 92.0f;
-  player.x = 120.0f;
-  player.y = groundY - player.h;
-
-  // Bull collider (no face)
-  bull.w = 86.0f;
-  bull.h = 62.0f;
+  player.box.w = 44.0f;
+  player.box.h = 92.0f;
+  player.box.x = 120.0f;
+  player.box.y = groundY - player.box.h;
+
+  // sprite kinds (sheet layout comes from the clip tables too)
+  kindPlayer = spriteKind(PLAYER_ANIM);
+  kindBull = spriteKind(BULL_ANIM, SDL_Color{ 210, 70, 70, 255 });
+  const anim::AnimSet& playerAnim = spriteKinds[kindPlayer].anim;
+  playerClipIdle = playerAnim.find("idle");
+  playerClipRun = playerAnim.find("run");
+  playerClipJump = playerAnim.find("jump");
+  playerClipDuck = playerAnim.find("duck");
+  bullClipRun = spriteKinds[kindBull].anim.find("run");
+  kindBlock = spriteKind("assets/sprites/block.png", SDL_Color{ 90, 180, 120, 255 });
+  kindBar = spriteKind("assets/sprites/bar.png", SDL_Color{ 90, 140, 200, 255 });
 
   // ---- load textures ----
   // If these fail, game still runs (falls back to rectangles for that item)
   SDL_Renderer* r = (m_game ? m_game->renderer() : nullptr);
+  cpuCompositing = wantCpuCompositing(r);
   reloadTextures(r);
+  syncFrameBudget();
 
   playerAnimT = 0.0f;
-  bullAnimT   = 0.0f;
 
   startLevel(0);
 }
 
 GameScene::~GameScene() {
-  destroyTex(texPlayerSheet);
-  destroyTex(texBullSheet);
-  destroyTex(texBlock);
-  destroyTex(texBar);
-  destroyTex(texBg);
+  for (SpriteKind& k : spriteKinds) destroySheet(k.sheet);
+  textures::destroy(texBg);
+  textures::destroy(sceneTarget);
+  textures::destroy(cpuTexture);
 }
 
 void GameScene::buildLevels() {
-  levels.clear();
-  levels.reserve(10);
-
-  for (int i = 0; i < 10; ++i) {
-    LevelDef d;
-    d.length = 3200.0f + i * 450.0f;
-    d.bullSpeedBonus = i * 18.0f;
-    d.obstacleCount = 10 + i * 2;
-    d.obstacleSpacing = std::max(170.0f, 270.0f - i * 9.0f);
-    levels.push_back(d);
-  }
+  levels = levelgen::campaign();
 }
 
 void GameScene::startLevel(int idx) {
   levelIndex = std::clamp(idx, 0, (int)levels.size() - 1);
   waitingForEnter = false;
 
+  const bool authored = loadLevelFile(levelIndex);
+
   const LevelDef& def = levels[levelIndex];
-  goalX = def.length;
+  originChunk = 0;
+  goalX = (float)(def.length - originX());
 
   // reset player
-  player.x = 120.0f;
-  player.h = 92.0f;
-  player.y = groundY - player.h;
-  vx = 0.0f;
-  vy = 0.0f;
-  onGround = true;
-  ducking = false;
-
-  // reset bull behind player
-  bull.x = player.x - 260.0f;
-  bull.y = groundY - bull.h;
+  player.box.x = 120.0f;
+  player.box.h = 92.0f;
+  player.box.y = groundY - player.box.h;
+  player.vx = 0.0f;
+  player.vy = 0.0f;
+  player.onGround = true;
+  player.ducking = false;
+
+  // reset bull herd behind player
   bullSpeed = bullBaseSpeed + def.bullSpeedBonus;
+  spawnChasers(def);
 
   // camera
   camX = 0.0f;
 
   // obstacles
-  generateObstacles(def);
+  if (!authored) generateObstacles(def);
+  obstacles.clear();
+  for (const LevelObstacle& o : levelObstacles) obstacles.push_back(toLocal(o, originX()));
 
   // HUD strings
   hudLevelText = "Level " + std::to_string(levelIndex + 1) + " / " + std::to_string((int)levels.size());
@@ -178,49 +151,279 @@ void GameScene::startLevel(int idx) {
 
   // reset anim timers
   playerAnimT = 0.0f;
-  bullAnimT   = 0.0f;
+
+  particles.clear();
+  bullDustT = 0.0f;
 
   // reset gesture/touch state (safe)
   gestureActive = false;
-  gestureSwiped = false;
   clearTouchHeld(rightHeld, duckHeld, touchRunHeld, touchDuckHeld);
+
+  // new layout: older snapshots no longer apply
+  ++layoutId;
+  history.clear();
+  runTime = 0.0f;
+  captureSnapshot(levelStartSnapshot);
+
+  loadGhost();
+  restartGhostRecording();
+  telemetry::record(telemetry::Event::LevelStart, (uint16_t)levelIndex, 0.0f, authored ? 1u : 0u);
+}
+
+// Retry on the same layout: restore the start-of-level snapshot instead of
+// regenerating (and re-validating) obstacles.
+void GameScene::restartLevel() {
+  if (!restoreSnapshot(levelStartSnapshot)) {
+    startLevel(levelIndex);
+    return;
+  }
+
+  waitingForEnter = false;
+  overlayText.clear();
+  history.clear();
+  particles.clear();
+  jumpPressed = false;
+
+  // same input reset as startLevel: a held touch must not carry into the retry
+  gestureActive = false;
+  clearTouchHeld(rightHeld, duckHeld, touchRunHeld, touchDuckHeld);
+  restartGhostRecording();
+}
+
+void GameScene::captureSnapshot(SimSnapshot& out) const {
+  out.layoutId = layoutId;
+  out.originChunk = originChunk;
+  out.player = player;
+  out.camX = camX;
+  out.playerAnimT = playerAnimT;
+  out.bullDustT = bullDustT;
+  out.runTime = runTime;
+
+  out.chaserCount = 0;
+  const auto& chasers = world.pool<ecs::Chaser>();
+  for (size_t i = 0; i < chasers.size() && out.chaserCount < kMaxSnapshotChasers; ++i) {
+    const ecs::Entity e = chasers.entities()[i];
+    ChaserSnapshot& c = out.chasers[out.chaserCount++];
+    c.entity = e;
+    c.rect = world.get<ecs::Transform>(e).rect;
+    c.vx = world.get<ecs::Velocity>(e).vx;
+    c.vy = world.get<ecs::Velocity>(e).vy;
+    c.onGround = world.get<ecs::Body>(e).onGround;
+    c.animT = world.get<ecs::Sprite>(e).anim.t;
+  }
 }
 
-void GameScene::restartLevel() { startLevel(levelIndex); }
+// Fails (changing nothing) if the snapshot belongs to another layout.
+bool GameScene::restoreSnapshot(const SimSnapshot& s) {
+  if (s.layoutId != layoutId) return false;
+
+  rebaseOrigin(s.originChunk); // positions below are in the snapshot's frame
+  player = s.player;
+  camX = s.camX;
+  playerAnimT = s.playerAnimT;
+  bullDustT = s.bullDustT;
+  runTime = s.runTime;
+
+  for (int i = 0; i < s.chaserCount; ++i) {
+    const ChaserSnapshot& c = s.chasers[i];
+    if (!world.alive(c.entity)) continue;
+    world.get<ecs::Transform>(c.entity).rect = c.rect;
+    world.get<ecs::Velocity>(c.entity) = ecs::Velocity{ c.vx, c.vy };
+    world.get<ecs::Body>(c.entity).onGround = c.onGround;
+    world.get<ecs::Sprite>(c.entity).anim.t = c.animT;
+  }
+  return true;
+}
 
+// Moves the origin to `chunk`. Dynamic state (player, bulls, camera,
+// particles) is shifted in place; static geometry and the goal are
+// recomputed from level space so repeated rebases never accumulate error.
+void GameScene::rebaseOrigin(int64_t chunk) {
+  if (chunk == originChunk) return;
+  TRACE_SCOPE("GameScene::rebaseOrigin");
+
+  const float shift = (float)((double)(chunk - originChunk) * kOriginChunk);
+  originChunk = chunk;
+  const double ox = originX();
+
+  player.box.x -= shift;
+  camX -= shift;
+  for (ecs::Transform& t : world.pool<ecs::Transform>().components()) t.rect.x -= shift;
+  particles.shiftX(-shift);
+
+  goalX = (float)(levels[levelIndex].length - ox);
+  for (size_t i = 0; i < obstacles.size() && i < levelObstacles.size(); ++i) {
+    obstacles[i] = toLocal(levelObstacles[i], ox);
+  }
+}
+
+void GameScene::maybeRebaseOrigin() {
+  if (player.box.x < kOriginChunk * 2.0f) return;
+  rebaseOrigin(originChunk + (int64_t)std::floor(player.box.x / kOriginChunk));
+}
+
+// Candidate seeds are a fixed sequence per (campaignSeed, level), so every
+// session picks the same layout; they are checked in parallel and the first
+// solvable one in seed order wins. If every candidate fails the last one is kept, so the game
+// never stalls on a bad level def.
+//
+// Without worker threads every check would run back to back inside
+// startLevel, so only one batch is tried there, one seed at a time up to
+// the first solvable one (same seeds, so the same pick as the parallel
+// path whenever that batch has a solvable layout).
 void GameScene::generateObstacles(const LevelDef& def) {
-  obstacles.clear();
-  obstacles.reserve(def.obstacleCount);
-
-  float x = 520.0f;
-  for (int i = 0; i < def.obstacleCount; ++i) {
-    float jitter = (frand01() - 0.5f) * 120.0f;
-    x += def.obstacleSpacing + jitter;
-
-    Obstacle o;
-    bool makeDuck = (frand01() < 0.45f);
-
-    if (makeDuck) {
-      // overhead bar
-      o.type = ObstacleType::DuckUnder;
-      o.rect.w = 140.0f;
-      o.rect.h = 24.0f;
-      o.rect.x = x;
-      o.rect.y = (groundY - 92.0f) + 22.0f;
+  TRACE_SCOPE("GameScene::generateObstacles");
+  static constexpr int kBatches = 4;
+  static constexpr int kCandidatesPerBatch = 4;
+
+  levelcheck::Scenario sc;
+  sc.bull.x = -1e9f;
+  sc.tuning = playerTuning();
+  sc.start = player;
+  sc.goalX = goalX;
+  sc.bullSpeed = bullSpeed;
+  world.each<ecs::Chaser, ecs::Transform>([&](ecs::Entity, ecs::Chaser&, ecs::Transform& t) {
+    if (t.rect.x + t.rect.w > sc.bull.x + sc.bull.w) sc.bull = t.rect; // lead bull
+  });
+
+  const bool parallel = jobs::workerCount() > 0;
+  const int batches = parallel ? kBatches : 1;
+
+  std::vector<uint32_t> seeds(kCandidatesPerBatch);
+  std::vector<uint32_t> oneSeed(1);
+  std::vector<levelcheck::SeedResult> results, oneResult;
+  uint32_t chosen = 0;
+  uint32_t candidate = 0;
+
+  for (int batch = 0; batch < batches; ++batch) {
+    for (uint32_t& seed : seeds) seed = candidateSeed(campaignSeed, levelIndex, candidate++);
+    if (parallel) {
+      levelcheck::validateSeeds(def, sc, seeds, results);
     } else {
-      // ground block (solid)
-      o.type = ObstacleType::JumpOver;
-      o.rect.w = 58.0f;
-      o.rect.h = 48.0f;
-      o.rect.x = x;
-      o.rect.y = groundY - o.rect.h;
+      results.clear();
+      for (uint32_t seed : seeds) {
+        oneSeed[0] = seed;
+        levelcheck::validateSeeds(def, sc, oneSeed, oneResult);
+        results.push_back(oneResult[0]);
+        if (oneResult[0].solvable) break;
+      }
+    }
+
+    chosen = seeds.back();
+    const auto ok = std::find_if(results.begin(), results.end(),
+                                 [](const levelcheck::SeedResult& r) { return r.solvable; });
+    if (ok != results.end()) { chosen = ok->seed; break; }
+
+    if (batch + 1 == batches) {
+      LOG_WARN("Level %d: no solvable layout in %d candidates, keeping the last one",
+               levelIndex + 1, batches * kCandidatesPerBatch);
     }
+  }
+
+  levelgen::generate(def, groundY, chosen, levelObstacles);
+}
+
+physics::PlayerTuning GameScene::playerTuning() const {
+  physics::PlayerTuning t;
+  t.gravity = gravity;
+  t.moveSpeed = moveSpeed;
+  t.jumpVelocity = jumpVelocity;
+  t.groundY = groundY;
+  t.standHeight = playerStandHeight;
+  return t;
+}
+
+// Replaces levels[idx] + levelObstacles with the authored file if one exists.
+bool GameScene::loadLevelFile(int idx) {
+  if (m_game && !m_game->levelFilesEnabled()) {
+    levelFilePath.clear();
+    levelFileMTime = 0;
+    return false;
+  }
 
-    if (o.rect.x < def.length - 220.0f) obstacles.push_back(o);
+  levelFilePath = levelFilePathFor(idx);
+  levelFileMTime = levelfile::modifiedTime(levelFilePath.c_str());
+  if (levelFileMTime == 0) return false;
+
+  levelfile::LevelFile file;
+  std::string err;
+  if (!file.open(levelFilePath.c_str(), err)) {
+    LOG_ERROR("Level file rejected (%s): %s", levelFilePath.c_str(), err.c_str());
+    return false;
+  }
+
+  levels[idx] = file.def();
+  levelObstacles.assign(file.obstacles(), file.obstacles() + file.obstacleCount());
+  return true;
+}
+
+// Debug builds: restart the level when its file changes on disk.
+void GameScene::pollLevelFileReload(float dt) {
+#ifndef NDEBUG
+  static constexpr float kPollInterval = 0.5f;
+
+  levelReloadPollT += dt;
+  if (levelReloadPollT < kPollInterval) return;
+  levelReloadPollT = 0.0f;
+
+  const long long mtime = levelfile::modifiedTime(levelFilePath.c_str());
+  if (mtime != 0 && mtime != levelFileMTime) {
+    LOG_INFO("Level file changed, reloading: %s", levelFilePath.c_str());
+    startLevel(levelIndex);
+  }
+#else
+  (void)dt;
+#endif
+}
+
+// Debug builds: F5 writes the current layout so it can be hand-edited.
+void GameScene::saveCurrentLevelFile() {
+#ifndef NDEBUG
+  if (levelFilePath.empty()) return; // level files disabled
+  std::string err;
+  if (levelfile::save(levelFilePath.c_str(), levels[levelIndex], levelObstacles, err)) {
+    levelFileMTime = levelfile::modifiedTime(levelFilePath.c_str());
+    LOG_INFO("Saved level layout: %s", levelFilePath.c_str());
+  } else {
+    LOG_ERROR("Saving level layout failed (%s): %s", levelFilePath.c_str(), err.c_str());
+  }
+#endif
+}
+
+void GameScene::spawnChasers(const LevelDef& def) {
+  world.clear();
+
+  // capped so every bull fits in a SimSnapshot
+  const int count = std::clamp(def.chaserCount, 1, kMaxSnapshotChasers);
+  world.pool<ecs::Transform>().reserve(count);
+  world.pool<ecs::Velocity>().reserve(count);
+  world.pool<ecs::Body>().reserve(count);
+  world.pool<ecs::Chaser>().reserve(count);
+  world.pool<ecs::Sprite>().reserve(count);
+
+  // Lead bull starts 260 behind the player; the herd trails it.
+  for (int i = 0; i < count; ++i) {
+    ecs::Entity e = world.create();
+
+    ecs::Transform t;
+    t.rect = { player.box.x - 260.0f - i * herdSpacing, groundY - bullH, bullW, bullH };
+    world.add(e, t);
+    world.add(e, ecs::Velocity{});
+    world.add(e, ecs::Body{});
+    world.add(e, ecs::Chaser{ bullSpeed });
+
+    ecs::Sprite spr;
+    spr.sheet = kindBull;
+    spr.anim.clip = (uint16_t)bullClipRun;
+    spr.anim.t = i * 0.37f; // desync gallop cycles
+    world.add(e, spr);
   }
 }
 
 void GameScene::handleEvent(const SDL_Event& e) {
+  // dragged onto another monitor: its refresh rate sets the budget
+  if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_MOVED) syncFrameBudget();
+
   // -------- keyboard input (unchanged) --------
   if (e.type == SDL_KEYDOWN && !e.key.repeat) {
     switch (e.key.keysym.sym) {
@@ -237,6 +440,23 @@ void GameScene::handleEvent(const SDL_Event& e) {
       case SDLK_w:     jumpPressed = true; break;
       case SDLK_SPACE: jumpPressed = true; break;
 
+      case SDLK_r:     rewindHeld = true; break;
+
+      case SDLK_F5:
+        saveCurrentLevelFile();
+        break;
+
+      case SDLK_F3:
+        cpuCompositing = !cpuCompositing;
+        LOG_INFO("CPU compositing: %s", cpuCompositing ? "on" : "off");
+        reloadTextures(m_game ? m_game->renderer() : nullptr);
+        break;
+
+      case SDLK_F4:
+        resolution.setEnabled(!resolution.enabled());
+        LOG_INFO("Dynamic resolution: %s", resolution.enabled() ? "on" : "off");
+        break;
+
       case SDLK_RETURN:
         if (waitingForEnter) {
           int next = levelIndex + 1;
@@ -260,235 +480,203 @@ void GameScene::handleEvent(const SDL_Event& e) {
       case SDLK_DOWN:  duckHeld = false; break;
       case SDLK_s:     duckHeld = false; break;
 
+      case SDLK_r:     rewindHeld = false; break;
+
       default: break;
     }
   }
+}
 
-  // ------------------------------------------
-  // Touch + Mouse gestures (additive, safe)
-  // ------------------------------------------
-  const bool isPointerDown =
-    (e.type == SDL_FINGERDOWN) ||
-    (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT);
-
-  const bool isPointerUp =
-    (e.type == SDL_FINGERUP) ||
-    (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT);
-
-  const bool isPointerMove =
-    (e.type == SDL_FINGERMOTION) ||
-    (e.type == SDL_MOUSEMOTION);
-
-  if (isPointerDown) {
-    int rw = 960, rh = 540;
-    if (m_game) m_game->getRenderSize(rw, rh);
-    if (rw > 0 && rh > 0) { viewportW = rw; viewportH = rh; }
-
-    getInputPosPixels(e, rw, rh, gestureStartX, gestureStartY);
-    gestureCurX = gestureStartX;
-    gestureCurY = gestureStartY;
-
-    gestureActive = true;
-    gestureSwiped = false;
+// Touch + mouse (additive, won't affect keyboard-held keys): holding
+// anywhere runs forward, swipe up jumps, swipe down ducks while held.
+void GameScene::handlePointer(const input::PointerEvent& p) {
+  if (p.action == input::PointerAction::Down) {
     clearTouchHeld(rightHeld, duckHeld, touchRunHeld, touchDuckHeld);
-
-    // Holding anywhere keeps the player running forward.
+    gestureActive = true;
     rightHeld = true;
     touchRunHeld = true;
-  }
-
-  if (gestureActive && isPointerMove) {
-    int rw = 960, rh = 540;
-    if (m_game) m_game->getRenderSize(rw, rh);
-    if (rw > 0 && rh > 0) { viewportW = rw; viewportH = rh; }
-
-    getInputPosPixels(e, rw, rh, gestureCurX, gestureCurY);
-
-    const float dy = gestureCurY - gestureStartY;
-    const float absDy = std::fabs(dy);
-
-    const float thresh = std::max(swipeThresholdPx, 0.08f * (float)rh);
-
-    if (!gestureSwiped && absDy >= thresh) {
-      gestureSwiped = true;
-
-      // Swipe Up => Jump
-      if (dy < 0.0f) {
-        jumpPressed = true;
-      }
-      // Swipe Down => Duck while held
-      else {
-        duckHeld = true;
-        touchDuckHeld = true;
-      }
-    }
-  }
-
-  if (gestureActive && isPointerUp) {
+  } else if (p.action == input::PointerAction::Up && gestureActive) {
     gestureActive = false;
-    gestureSwiped = false;
-
-    // Release what touch/mouse held (won't affect keyboard-held keys)
     clearTouchHeld(rightHeld, duckHeld, touchRunHeld, touchDuckHeld);
   }
 }
 
-void GameScene::applyInput() {
-  // horizontal
-  vx = 0.0f;
-  if (leftHeld)  vx -= moveSpeed;
-  if (rightHeld) vx += moveSpeed;
-
-  // duck (only grounded)
-  if (duckHeld && onGround) {
-    if (!ducking) {
-      ducking = true;
-      float oldH = player.h;
-      player.h = 56.0f;
-      player.y += (oldH - player.h); // keep feet grounded
-    }
+void GameScene::handleGesture(const input::GestureEvent& g) {
+  if (!gestureActive) return;
+  if (g.kind == input::GestureKind::SwipeUp) {
+    jumpPressed = true;
   } else {
-    if (ducking) {
-      // stand up only if not colliding when standing
-      float oldH = player.h;
-      float newH = 92.0f;
-
-      SDL_FRect test = player;
-      test.y -= (newH - oldH);
-      test.h = newH;
-
-      bool blocked = false;
-      for (const auto& o : obstacles) {
-        if (!isSolidForPlayer(o, /*ducking=*/false)) continue;
-        if (AABB(test, o.rect)) { blocked = true; break; }
-      }
-
-      if (!blocked) {
-        ducking = false;
-        player.h = newH;
-        player.y = test.y;
-      }
-    }
-  }
-
-  // jump
-  if (jumpPressed && onGround && !ducking) {
-    vy = jumpVelocity;
-    onGround = false;
+    duckHeld = true;
+    touchDuckHeld = true;
   }
 }
 
 void GameScene::update(float dt) {
+  TRACE_SCOPE("GameScene::update");
   syncViewportMetrics();
+  pollLevelFileReload(dt);
+  resolution.addFrame(dt);
 
   if (waitingForEnter) {
     jumpPressed = false;
     return;
   }
 
-  applyInput();
+  // Rewind: step back one recorded frame per update, no simulation.
+  if (rewindHeld) {
+    if (history.size() > 1) history.popBack();
+    if (!history.empty()) restoreSnapshot(history.back());
+    ghostRecorder.truncate(runTime);
+    jumpPressed = false;
+    return;
+  }
 
   // advance animations
   playerAnimT += dt;
-  bullAnimT   += dt;
-
-  // gravity
-  vy += gravity * dt;
-
-  // Previous vertical state for crossing checks
-  const float prevY = player.y;
-  const float prevBottom = prevY + player.h;
-
-  // 1) Move X, resolve X collisions
-  player.x += vx * dt;
-  if (player.x < 30.0f) player.x = 30.0f;
-
-  if (vx != 0.0f) {
-    for (const auto& o : obstacles) {
-      if (!isSolidForPlayer(o, ducking)) continue;
-      if (!AABB(player, o.rect)) continue;
-
-      if (vx > 0.0f) player.x = o.rect.x - player.w;
-      else           player.x = o.rect.x + o.rect.w;
-    }
+  runTime += dt;
+
+  physics::PlayerInput in;
+  in.left = leftHeld;
+  in.right = rightHeld;
+  in.duck = duckHeld;
+  in.jump = jumpPressed;
+
+  const unsigned events = physics::stepPlayer(player, in, playerTuning(),
+                                              obstacles.data(), obstacles.size(), dt);
+  if (events & physics::PlayerJumped) {
+    audio::play(audio::Sound::Jump, 0.8f);
+    telemetry::record(telemetry::Event::Jump, (uint16_t)levelIndex, (float)absolutePlayerX());
   }
-
-  // 2) Move Y, resolve Y collisions
-  player.y += vy * dt;
-  onGround = false;
-
-  for (const auto& o : obstacles) {
-    if (!isSolidForPlayer(o, ducking)) continue;
-    if (!AABB(player, o.rect)) continue;
-
-    const float oTop = o.rect.y;
-    const float oBottom = o.rect.y + o.rect.h;
-
-    const float pTop = player.y;
-    const float pBottom = player.y + player.h;
-
-    if (vy > 0.0f) {
-      // falling -> land on top
-      if (prevBottom <= oTop + 0.5f && pBottom >= oTop) {
-        player.y = oTop - player.h;
-        vy = 0.0f;
-        onGround = true;
-      }
-    } else if (vy < 0.0f) {
-      // rising -> bonk underside
-      if (prevY >= oBottom - 0.5f && pTop <= oBottom) {
-        player.y = oBottom;
-        vy = 0.0f;
-      }
-    } else {
-      // vy == 0, overlapping: prefer standing if we were above
-      if (prevBottom <= oTop + 2.0f) {
-        player.y = oTop - player.h;
-        onGround = true;
-      } else {
-        player.y = oBottom;
-      }
-    }
+  if (events & physics::PlayerDucked) {
+    emitDuckPuff();
+    audio::play(audio::Sound::Duck, 0.6f);
+    telemetry::record(telemetry::Event::Duck, (uint16_t)levelIndex, (float)absolutePlayerX());
   }
-
-  // 3) World ground
-  float floorY = groundY - player.h;
-  if (player.y >= floorY) {
-    player.y = floorY;
-    vy = 0.0f;
-    onGround = true;
+  if (events & physics::PlayerLanded) {
+    emitLandingDust();
+    audio::play(audio::Sound::Land, 0.7f);
   }
 
-  // bull chase
-  bull.x += bullSpeed * dt;
-  bull.y = groundY - bull.h;
+  // bull herd
+  ecs::runChasers(world);
+  ecs::applyGravity(world, gravity, dt);
+  ecs::integrateMotion(world, dt);
+  ecs::collideWithLevel(world, groundY, obstacles);
+  ecs::advanceSprites(world, dt);
+
+  // effects
+  emitBullDust(dt);
+  playBullSteps(dt);
+  particles.update(dt, gravity, groundY);
+
+  ghostRecorder.record(runTime, ghostSample());
 
   // camera follow
   const float viewportWorldWidth = (float)viewportW / std::max(0.01f, zoomScale);
-  float targetCam = player.x - viewportWorldWidth * 0.30f;
-  const float maxCam = std::max(0.0f, goalX - viewportWorldWidth);
-  camX = std::clamp(targetCam, 0.0f, maxCam);
+  float targetCam = player.box.x - viewportWorldWidth * 0.30f;
+  const float minCam = (float)-originX(); // level start, in origin-relative units
+  const float maxCam = std::max(minCam, goalX - viewportWorldWidth);
+  camX = std::clamp(targetCam, minCam, maxCam);
 
   // conditions
   checkCaught();
   checkGoalReached();
 
+  maybeRebaseOrigin();
+  if (!waitingForEnter) captureSnapshot(history.push());
+
   jumpPressed = false;
 }
 
-bool GameScene::intersects(const SDL_FRect& a, const SDL_FRect& b) const {
-  return AABB(a, b);
+void GameScene::emitLandingDust() {
+  ParticleBurst b;
+  b.x = player.box.x + player.box.w * 0.5f;
+  b.y = player.box.y + player.box.h;
+  b.count = 28;
+  b.angleMin = -3.14159f;
+  b.angleMax = 0.0f;
+  b.speedMin = 60.0f;
+  b.speedMax = 200.0f;
+  b.gravityScale = 0.35f;
+  particles.emit(b);
+}
+
+void GameScene::emitDuckPuff() {
+  ParticleBurst b;
+  b.x = player.box.x + player.box.w * 0.5f;
+  b.y = player.box.y + player.box.h;
+  b.count = 10;
+  b.speedMin = 30.0f;
+  b.speedMax = 110.0f;
+  b.lifeMax = 0.35f;
+  b.size = 4.0f;
+  particles.emit(b);
+}
+
+void GameScene::emitBullDust(float dt) {
+  static constexpr float kInterval = 0.06f;
+
+  bullDustT += dt;
+  if (bullDustT < kInterval) return;
+  bullDustT -= kInterval;
+  if (bullDustT > kInterval) bullDustT = 0.0f; // don't burst-catch-up after hitches
+
+  ParticleBurst b;
+  b.count = 3;
+  b.angleMin = -3.14159f;       // kicked backwards and up
+  b.angleMax = -3.14159f * 0.6f;
+  b.speedMin = 40.0f;
+  b.speedMax = 140.0f;
+  b.lifeMin = 0.3f;
+  b.lifeMax = 0.7f;
+  b.size = 7.0f;
+  b.color = SDL_Color{ 170, 150, 120, 180 };
+
+  world.each<ecs::Chaser, ecs::Transform>([&](ecs::Entity, ecs::Chaser&, ecs::Transform& t) {
+    b.x = t.rect.x + t.rect.w * 0.25f;
+    b.y = t.rect.y + t.rect.h;
+    particles.emit(b);
+  });
+}
+
+// One hoof beat for the herd, louder as the lead bull closes in and panned
+// to where it is on screen.
+void GameScene::playBullSteps(float dt) {
+  static constexpr float kInterval = 0.24f;
+
+  bullStepT += dt;
+  if (bullStepT < kInterval) return;
+  bullStepT -= kInterval;
+  if (bullStepT > kInterval) bullStepT = 0.0f;
+
+  float front = -1e30f;
+  world.each<ecs::Chaser, ecs::Transform>([&](ecs::Entity, ecs::Chaser&, ecs::Transform& t) {
+    front = std::max(front, t.rect.x + t.rect.w);
+  });
+  if (front < -1e29f) return;
+
+  const float gap = std::max(0.0f, player.box.x - front);
+  const float volume = std::clamp(1.0f - gap / 700.0f, 0.15f, 1.0f);
+  const float screenX = (front - camX) * zoomScale / (float)std::max(1, viewportW);
+  audio::play(audio::Sound::BullStep, volume, screenX * 2.0f - 1.0f);
 }
 
 void GameScene::checkCaught() {
-  if (intersects(bull, player) || (bull.x + bull.w) >= (player.x + 8.0f)) {
+  if (ecs::findCatchingChaser(world, player.box, 8.0f) != ecs::kNullEntity) {
+    audio::play(audio::Sound::Caught);
+    telemetry::record(telemetry::Event::Death, (uint16_t)levelIndex, (float)absolutePlayerX(),
+                      (uint32_t)(runTime * 1000.0f));
     restartLevel();
   }
 }
 
 void GameScene::checkGoalReached() {
-  if (player.x >= goalX && !waitingForEnter) {
+  if (player.box.x >= goalX && !waitingForEnter) {
     waitingForEnter = true;
+    audio::play(audio::Sound::Goal);
+    telemetry::record(telemetry::Event::LevelComplete, (uint16_t)levelIndex, (float)absolutePlayerX(),
+                      (uint32_t)(runTime * 1000.0f));
+    finishGhostRun();
 
     const int nextHuman = levelIndex + 2;
     const bool hasNext = nextHuman <= (int)levels.size();
@@ -500,10 +688,53 @@ void GameScene::checkGoalReached() {
 }
 
 void GameScene::render(SDL_Renderer* ren) {
+  TRACE_SCOPE("GameScene::render");
   syncViewportMetrics();
   int rw = viewportW;
   int rh = viewportH;
 
+  if (!(cpuCompositing && renderWorldCpu(ren))) renderWorldGpu(ren);
+
+  // progress bar
+  const double levelLength = std::max(1.0, levels[levelIndex].length);
+  float t = (float)std::clamp(absolutePlayerX() / levelLength, 0.0, 1.0);
+  SDL_SetRenderDrawColor(ren, 120, 160, 240, 255);
+  SDL_FRect bar { 20.0f, 20.0f, (rw - 40.0f) * t, 10.0f };
+  SDL_RenderFillRectF(ren, &bar);
+
+  // HUD: current level label
+  if (m_game && m_game->font()) {
+    SDL_FRect hudBox { 20.0f, 44.0f, 260.0f, 34.0f };
+    drawTextCentered(ren, m_game->font(), hudLevelText.c_str(), hudBox);
+  }
+
+  // overlay when waiting for Enter
+  if (waitingForEnter) {
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(ren, 0, 0, 0, 140);
+    SDL_FRect overlay { 0.0f, 0.0f, (float)rw, (float)rh };
+    SDL_RenderFillRectF(ren, &overlay);
+
+    SDL_SetRenderDrawColor(ren, 240, 240, 240, 220);
+    SDL_FRect panel { rw * 0.20f, rh * 0.35f, rw * 0.60f, rh * 0.30f };
+    SDL_RenderFillRectF(ren, &panel);
+
+    if (m_game && m_game->font() && !overlayText.empty()) {
+      SDL_FRect msgBox { panel.x, panel.y, panel.w, panel.h };
+      drawTextCentered(ren, m_game->font(), overlayText.c_str(), msgBox);
+    }
+
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_NONE);
+  }
+}
+
+// World pass through the SDL renderer.
+void GameScene::renderWorldGpu(SDL_Renderer* ren) {
+  int rw = viewportW;
+  int rh = viewportH;
+
+  const bool scaledPass = beginWorldPass(ren);
+
   // background
   SDL_SetRenderDrawColor(ren, 10, 12, 16, 255);
   SDL_RenderClear(ren);
@@ -519,161 +750,374 @@ void GameScene::render(SDL_Renderer* ren) {
     }
   }
 
-  // ground band
-  SDL_SetRenderDrawColor(ren, 40, 45, 55, 255);
-  SDL_FRect ground { 0.0f, screenGroundY, (float)rw, (float)rh - screenGroundY };
-  if (ground.y < 0.0f) {
-    ground.h += ground.y;
-    ground.y = 0.0f;
+  buildWorldDraws();
+  for (const WorldDraw& d : worldDraws) {
+    const SpriteSheet* sheet = d.kind != kNoSheet ? &spriteKinds[d.kind].sheet : nullptr;
+    if (sheet && sheet->valid()) {
+      if (d.color.a != 255) SDL_SetTextureAlphaMod(sheet->texture, d.color.a);
+      sheet->draw(ren, d.frame, d.rect, d.flip);
+      if (d.color.a != 255) SDL_SetTextureAlphaMod(sheet->texture, 255);
+    } else {
+      const bool blend = d.color.a != 255;
+      if (blend) SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+      SDL_SetRenderDrawColor(ren, d.color.r, d.color.g, d.color.b, d.color.a);
+      SDL_RenderFillRectF(ren, &d.rect);
+      if (blend) SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_NONE);
+    }
   }
-  if (ground.h < 0.0f) ground.h = 0.0f;
-  SDL_RenderFillRectF(ren, &ground);
 
-  // goal marker
-  SDL_SetRenderDrawColor(ren, 190, 200, 220, 255);
-  SDL_FRect goalRect = toScreenRect(SDL_FRect{ goalX, groundY - 160.0f, 16.0f, 160.0f });
-  SDL_RenderFillRectF(ren, &goalRect);
+  // dust / impact particles (one batched draw)
+  particles.render(ren, camX, zoomScale, groundY, screenGroundY);
 
-  // obstacles
-  for (const auto& o : obstacles) {
-    SDL_FRect rf = toScreenRect(o.rect);
-
-    if (o.type == ObstacleType::JumpOver) {
-      if (texBlock) SDL_RenderCopyF(ren, texBlock, nullptr, &rf);
-      else {
-        SDL_SetRenderDrawColor(ren, 90, 180, 120, 255);
-        SDL_RenderFillRectF(ren, &rf);
-      }
-    } else {
-      if (texBar) SDL_RenderCopyF(ren, texBar, nullptr, &rf);
-      else {
-        SDL_SetRenderDrawColor(ren, 90, 140, 200, 255);
-        SDL_RenderFillRectF(ren, &rf);
-      }
-    }
+  endWorldPass(ren, scaledPass);
+}
+
+// Everything in the world pass except the background and particles:
+// culled, animated and mapped to screen space once per frame, in draw
+// order. Both backends only emit this list.
+void GameScene::buildWorldDraws() {
+  worldDraws.clear();
+  const float rw = (float)viewportW;
+  const float rh = (float)viewportH;
+  const zoom::Camera cam = worldCamera();
+  const SDL_FRect view { 0.0f, 0.0f, rw, rh };
+
+  // ground band
+  const float groundTop = std::max(0.0f, screenGroundY);
+  worldDraws.push_back(WorldDraw{ SDL_FRect{ 0.0f, groundTop, rw, std::max(0.0f, rh - groundTop) },
+                                  kNoSheet, 0, false, SDL_Color{ 40, 45, 55, 255 } });
+
+  // goal marker
+  worldDraws.push_back(WorldDraw{ zoom::worldToScreen(cam, SDL_FRect{ goalX, groundY - 160.0f, 16.0f, 160.0f }),
+                                  kNoSheet, 0, false, SDL_Color{ 190, 200, 220, 255 } });
+
+  // obstacles (transformed + culled in one batch)
+  screenRects.resize(obstacles.size());
+  visibleIdx.resize(obstacles.size());
+  const int visibleObstacles = obstacles.empty() ? 0 :
+    zoom::worldToScreenBatch(cam, &obstacles[0].rect, sizeof(Obstacle), (int)obstacles.size(),
+                             view, screenRects.data(), visibleIdx.data());
+
+  for (int k = 0; k < visibleObstacles; ++k) {
+    const Obstacle& o = obstacles[(size_t)visibleIdx[(size_t)k]];
+    pushSprite(o.type == ObstacleType::JumpOver ? kindBlock : kindBar, 0, screenRects[(size_t)k]);
   }
 
-  // bull (2 rows x 4 cols)
-  {
-    SDL_FRect bf = toScreenRect(bull);
+  // entity sprites (bull herd), one sheet at a time
+  collectSprites(cam, view);
 
-    if (texBullSheet) {
-      int texW = 0, texH = 0;
-      SDL_QueryTexture(texBullSheet, nullptr, nullptr, &texW, &texH);
+  // ghost of the best run, under the player
+  SDL_FRect gb{};
+  int gFrame = 0;
+  bool gFlip = false;
+  if (ghostBox(gb, gFrame, gFlip)) pushSprite(kindPlayer, gFrame, zoom::worldToScreen(cam, gb), gFlip, GHOST_ALPHA);
 
-      if (texW > 0 && texH > 0) {
-        const int frameW = texW / BULL_COLS;
-        const int frameH = texH / BULL_ROWS;
+  // player
+  pushSprite(kindPlayer, playerFrame(), zoom::worldToScreen(cam, player.box), player.vx < 0.0f);
+}
 
-        const int totalFrames = BULL_COLS * BULL_ROWS;
-        int f = (int)(bullAnimT * BULL_RUN_FPS) % std::max(1, totalFrames);
-        int row = f / BULL_COLS;
-        int col = f % BULL_COLS;
+void GameScene::pushSprite(uint16_t kind, int frame, const SDL_FRect& rect, bool flip, Uint8 alpha) {
+  SDL_Color c = spriteKinds[kind].fallback;
+  c.a = alpha;
+  worldDraws.push_back(WorldDraw{ rect, kind, frame, flip, c });
+}
 
-        SDL_Rect src { col * frameW, row * frameH, frameW, frameH };
-        SDL_RenderCopyF(ren, texBullSheet, &src, &bf);
-      } else {
-        SDL_SetRenderDrawColor(ren, 210, 70, 70, 255);
-        SDL_RenderFillRectF(ren, &bf);
-      }
-    } else {
-      SDL_SetRenderDrawColor(ren, 210, 70, 70, 255);
-      SDL_RenderFillRectF(ren, &bf);
-    }
+ghost::Pose GameScene::playerPose() const {
+  return !player.onGround ? ghost::Pose::Jump
+       : player.ducking ? ghost::Pose::Duck
+       : std::abs(player.vx) > 1.0f ? ghost::Pose::Run
+       : ghost::Pose::Idle;
+}
+
+// Pose picks the clip, playerAnimT drives it.
+int GameScene::playerFrame() const {
+  int clip = playerClipIdle;
+  switch (playerPose()) {
+    case ghost::Pose::Idle: clip = playerClipIdle; break;
+    case ghost::Pose::Run:  clip = playerClipRun; break;
+    case ghost::Pose::Jump: clip = playerClipJump; break;
+    case ghost::Pose::Duck: clip = playerClipDuck; break;
   }
+  return anim::frameAt(spriteKinds[kindPlayer].anim.clips[(size_t)clip], playerAnimT);
+}
 
-  // player (row0 = 5 run frames, row1 col0=jump col1=duck)
-  {
-    SDL_FRect pf = toScreenRect(player);
-
-    if (texPlayerSheet) {
-      int texW = 0, texH = 0;
-      SDL_QueryTexture(texPlayerSheet, nullptr, nullptr, &texW, &texH);
-
-      if (texW > 0 && texH > 0) {
-        const int frameW = texW / PLAYER_RUN_COLS;
-        const int frameH = texH / PLAYER_ROWS;
-
-        SDL_Rect src{};
-
-        if (!onGround) {
-          // jump = row1 col0
-          src = { PLAYER_COL_JUMP * frameW, PLAYER_ROW_MISC * frameH, frameW, frameH };
-        } else if (ducking) {
-          // duck = row1 col1
-          src = { PLAYER_COL_DUCK * frameW, PLAYER_ROW_MISC * frameH, frameW, frameH };
-        } else {
-          // run = row0 col0..4
-          int frame = 0;
-          if (std::abs(vx) > 1.0f) {
-            frame = (int)(playerAnimT * PLAYER_RUN_FPS) % PLAYER_RUN_COLS;
-          }
-          src = { frame * frameW, PLAYER_ROW_RUN * frameH, frameW, frameH };
-        }
+// FNV-1a over the level length and the level-space obstacle records.
+uint32_t GameScene::layoutHash() const {
+  uint32_t h = 2166136261u;
+  auto mix = [&h](const void* p, size_t n) {
+    const unsigned char* b = (const unsigned char*)p;
+    for (size_t i = 0; i < n; ++i) h = (h ^ b[i]) * 16777619u;
+  };
+  mix(&levels[levelIndex].length, sizeof(double));
+  for (const LevelObstacle& o : levelObstacles) {
+    mix(&o.x, sizeof(o.x));
+    mix(&o.y, sizeof(o.y));
+    mix(&o.w, sizeof(o.w));
+    mix(&o.h, sizeof(o.h));
+    mix(&o.type, sizeof(o.type));
+  }
+  return h;
+}
 
-        bool flip = (vx < 0.0f);
-        SDL_RenderCopyExF(ren, texPlayerSheet, &src, &pf, 0.0, nullptr,
-                          flip ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
-      } else {
-        SDL_SetRenderDrawColor(ren, 220, 220, 220, 255);
-        SDL_RenderFillRectF(ren, &pf);
-      }
-    } else {
-      SDL_SetRenderDrawColor(ren, 220, 220, 220, 255);
-      SDL_RenderFillRectF(ren, &pf);
-    }
+// Best run for this level from the pref dir (none is not an error). A run
+// recorded on another layout is ignored; the next finished run replaces it.
+void GameScene::loadGhost() {
+  ghostBest = ghost::Track{};
+  ghostPlayer.setTrack(&ghostBest);
+  if (m_game && !m_game->ghostsEnabled()) return;
+
+  const std::string path = ghost::pathForLevel(levelIndex);
+  std::string error;
+  if (!path.empty() && levelfile::modifiedTime(path.c_str()) != 0 &&
+      !ghost::load(path.c_str(), ghostBest, error)) {
+    LOG_ERROR("Ghost load failed (%s): %s", path.c_str(), error.c_str());
   }
+  if (!ghostBest.empty() && ghostBest.layout != layoutHash()) ghostBest = ghost::Track{};
+}
 
-  // progress bar
-  float t = std::clamp(player.x / std::max(1.0f, goalX), 0.0f, 1.0f);
-  SDL_SetRenderDrawColor(ren, 120, 160, 240, 255);
-  SDL_FRect bar { 20.0f, 20.0f, (rw - 40.0f) * t, 10.0f };
-  SDL_RenderFillRectF(ren, &bar);
+ghost::Sample GameScene::ghostSample() const {
+  return ghost::Sample{ ghost::toQuarter(absolutePlayerX()), (int32_t)ghost::toQuarter(player.box.y),
+                        ghost::makeLook(playerPose(), player.vx < 0.0f, playerFrame()) };
+}
 
-  // HUD: current level label
-  if (m_game && m_game->font()) {
-    SDL_FRect hudBox { 20.0f, 44.0f, 260.0f, 34.0f };
-    drawTextCentered(ren, m_game->font(), hudLevelText.c_str(), hudBox);
+void GameScene::restartGhostRecording() {
+  ghostRecorder.reset();
+  ghostRecorder.record(runTime, ghostSample());
+}
+
+// Keeps (and saves) the run just finished if it beat the stored one.
+void GameScene::finishGhostRun() {
+  if (m_game && !m_game->ghostsEnabled()) return;
+  if (ghostRecorder.sampleCount() == 0) return;
+  if (!ghostBest.empty() && (uint32_t)ghostRecorder.sampleCount() >= ghostBest.sampleCount) return;
+
+  ghostBest = ghostRecorder.encode();
+  ghostBest.layout = layoutHash();
+  ghostPlayer.setTrack(&ghostBest);
+  LOG_INFO("Ghost: new best %.2f s (%zu bytes)", ghostBest.duration(), ghostBest.bytes());
+
+  const std::string path = ghost::pathForLevel(levelIndex);
+  std::string error;
+  if (!path.empty() && !ghost::save(path.c_str(), ghostBest, error)) {
+    LOG_ERROR("Ghost save failed (%s): %s", path.c_str(), error.c_str());
   }
+}
 
-  // overlay when waiting for Enter
-  if (waitingForEnter) {
-    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(ren, 0, 0, 0, 140);
-    SDL_FRect overlay { 0.0f, 0.0f, (float)rw, (float)rh };
-    SDL_RenderFillRectF(ren, &overlay);
+// Decodes the ghost at the current run time; cheap enough for every frame
+// (a keyframe seek at most, usually one sample).
+bool GameScene::ghostBox(SDL_FRect& box, int& frame, bool& flip) {
+  if (waitingForEnter) return false;
+
+  double x = 0.0, y = 0.0;
+  uint8_t look = 0;
+  if (!ghostPlayer.sampleAt(runTime, x, y, look)) return false;
+
+  box.x = (float)(x - originX());
+  box.y = (float)y;
+  box.w = player.box.w;
+  box.h = ghost::poseOf(look) == ghost::Pose::Duck ? playerTuning().duckHeight : playerStandHeight;
+  frame = ghost::frameOf(look);
+  flip = ghost::flipOf(look);
+  return true;
+}
 
-    SDL_SetRenderDrawColor(ren, 240, 240, 240, 220);
-    SDL_FRect panel { rw * 0.20f, rh * 0.35f, rw * 0.60f, rh * 0.30f };
-    SDL_RenderFillRectF(ren, &panel);
+// Same world pass as renderWorldGpu, rasterized by cpu::Canvas and
+// presented as one texture upload. Dynamic resolution shrinks the canvas
+// instead of the render target.
+bool GameScene::renderWorldCpu(SDL_Renderer* ren) {
+  TRACE_SCOPE("GameScene::renderWorldCpu");
+  const float rw = (float)viewportW;
+  const float rh = (float)viewportH;
+  const float s = std::min(1.0f, resolution.scale());
 
-    if (m_game && m_game->font() && !overlayText.empty()) {
-      SDL_FRect msgBox { panel.x, panel.y, panel.w, panel.h };
-      drawTextCentered(ren, m_game->font(), overlayText.c_str(), msgBox);
-    }
+  canvas.resize((int)std::ceil(rw * s), (int)std::ceil(rh * s));
+  canvas.setScale(s);
 
-    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_NONE);
+  // background
+  canvas.clear(SDL_Color{ 10, 12, 16, 255 });
+  if (!cpuBg.empty()) {
+    const float scale = rw / (float)cpuBg.w;
+    const float destH = (float)cpuBg.h * scale;
+    canvas.blit(cpuBg, SDL_Rect{ 0, 0, cpuBg.w, cpuBg.h }, SDL_FRect{ 0.0f, rh - destH, rw, destH });
+  }
+
+  buildWorldDraws();
+  for (const WorldDraw& d : worldDraws) {
+    const cpu::Atlas* atlas = d.kind != kNoSheet ? &spriteKinds[d.kind].atlas : nullptr;
+    if (atlas && atlas->valid()) canvas.blitFrame(*atlas, d.frame, d.rect, d.flip, d.color.a);
+    else canvas.fill(d.rect, d.color);
   }
+
+  particles.renderCpu(canvas, camX, zoomScale, groundY, screenGroundY);
+
+  canvas.flush();
+  return canvas.present(ren, cpuTexture);
 }
 
 void GameScene::reloadTextures(SDL_Renderer* r) {
-  destroyTex(texPlayerSheet);
-  destroyTex(texBullSheet);
-  destroyTex(texBlock);
-  destroyTex(texBar);
-  destroyTex(texBg);
+  TRACE_SCOPE("GameScene::reloadTextures");
+
+  for (SpriteKind& k : spriteKinds) {
+    destroySheet(k.sheet);
+    k.atlas = cpu::Atlas{};
+  }
+  textures::destroy(texBg);
+  textures::destroy(sceneTarget);
+  textures::destroy(cpuTexture);
+  sceneTargetW = sceneTargetH = 0;
+  cpuBg = cpu::Image{};
 
+  texturesLoaded = r != nullptr;
   if (!r) return;
 
-  texPlayerSheet = loadTexture(r, "assets/sprites/player_sheet.png");
-  texBullSheet   = loadTexture(r, "assets/sprites/bull_sheet.png");
-  texBlock       = loadTexture(r, "assets/sprites/block.png");
-  texBar         = loadTexture(r, "assets/sprites/bar.png");
-  texBg          = loadTexture(r, "assets/sprites/bg.png");
+  // Sprites are authored on large canvases: trim transparent margins and
+  // pack, keeping per-frame offsets so placement is unchanged. PNG decode +
+  // trimming run as jobs; only the uploads stay on this (renderer) thread.
+  struct SheetLoad {
+    const char* path;
+    int cols, rows;
+    SpriteSheet* sheet;
+    cpu::Atlas* atlas;
+    DecodedSheet decoded;
+  };
+  std::vector<SheetLoad> loads;
+  loads.reserve(spriteKinds.size());
+  for (SpriteKind& k : spriteKinds) {
+    loads.push_back({ k.anim.imagePath.c_str(), k.anim.cols, k.anim.rows, &k.sheet, &k.atlas, {} });
+  }
+  const char* bgPath = "assets/sprites/bg.png";
+  SDL_Surface* bgSurface = nullptr;
+
+  jobs::Counter decoded;
+  for (SheetLoad& l : loads) {
+    jobs::run([&l] { decodeTrimmedSheet(l.path, l.cols, l.rows, l.decoded); }, &decoded);
+  }
+  jobs::run([&bgSurface, bgPath] {
+    bgSurface = IMG_Load(bgPath);
+    if (!bgSurface) LOG_ERROR("IMG_Load failed (%s): %s", bgPath, IMG_GetError());
+  }, &decoded);
+  jobs::wait(decoded);
+
+  // CPU copies first: the upload consumes the decoded surfaces
+  if (cpuCompositing) {
+    for (SheetLoad& l : loads) cpu::atlasFromDecoded(l.decoded, *l.atlas);
+    if (bgSurface) cpu::imageFromSurface(bgSurface, cpuBg);
+  }
+
+  for (SheetLoad& l : loads) uploadTrimmedSheet(r, l.decoded, *l.sheet);
+  if (bgSurface) {
+    texBg = textures::createWithinBudget(r, bgSurface, bgPath, nullptr);
+    SDL_FreeSurface(bgSurface);
+  }
+}
+
+// `path` is an .anim file, or a plain image for a single-frame sprite.
+uint16_t GameScene::spriteKind(const char* path, SDL_Color fallback) {
+  for (size_t i = 0; i < spriteKinds.size(); ++i) {
+    if (spriteKinds[i].path == path) return (uint16_t)i;
+  }
+
+  SpriteKind k;
+  k.path = path;
+  k.fallback = fallback;
+  const size_t len = std::strlen(path);
+  if (len > 5 && std::strcmp(path + len - 5, ".anim") == 0) {
+    anim::load(path, k.anim);
+  } else {
+    k.anim.imagePath = path;
+    k.anim.clips.push_back(anim::Clip{ "still", { 0 } });
+  }
+  spriteKinds.push_back(std::move(k));
+
+  // a kind first used mid-session still needs its sheet uploaded (rare)
+  if (texturesLoaded) reloadTextures(m_game ? m_game->renderer() : nullptr);
+  return (uint16_t)(spriteKinds.size() - 1);
+}
+
+// Culls entity transforms in one batch, then resolves animation frames one
+// kind at a time (a single anim::resolve per sheet), so each sheet's
+// sprites land next to each other in worldDraws.
+void GameScene::collectSprites(const zoom::Camera& cam, const SDL_FRect& view) {
+  const auto& transforms = world.pool<ecs::Transform>();
+  const int n = (int)transforms.size();
+  if (n == 0) return;
+  screenRects.resize(std::max(screenRects.size(), (size_t)n));
+  visibleIdx.resize(std::max(visibleIdx.size(), (size_t)n));
+  const int visible = zoom::worldToScreenBatch(cam, &transforms.components()[0].rect, sizeof(ecs::Transform), n,
+                                               view, screenRects.data(), visibleIdx.data());
+
+  const std::vector<ecs::Sprite>& sprites = world.pool<ecs::Sprite>().components();
+  if (sprites.empty()) return;
+
+  for (size_t kind = 0; kind < spriteKinds.size(); ++kind) {
+    kindSprites.clear();
+    kindRects.clear();
+    for (int k = 0; k < visible; ++k) {
+      const ecs::Entity e = transforms.entities()[(size_t)visibleIdx[(size_t)k]];
+      const ecs::Sprite* spr = world.tryGet<ecs::Sprite>(e);
+      if (!spr || spr->sheet != kind) continue;
+      kindSprites.push_back((int)(spr - sprites.data()));
+      kindRects.push_back(k);
+    }
+    if (kindSprites.empty()) continue;
+
+    spriteFrames.resize(kindSprites.size());
+    anim::resolve(spriteKinds[kind].anim, &sprites[0].anim, sizeof(ecs::Sprite),
+                  kindSprites.data(), (int)kindSprites.size(), spriteFrames.data());
+    for (size_t i = 0; i < kindSprites.size(); ++i) {
+      pushSprite((uint16_t)kind, spriteFrames[i], screenRects[(size_t)kindRects[i]]);
+    }
+  }
+}
+
+// Redirects world drawing into sceneTarget at the controller's scale.
+// Draw calls keep using full-resolution coordinates; SDL_RenderSetScale
+// maps them into the smaller region. Returns false (draw directly) at
+// full scale or when render targets are unavailable.
+bool GameScene::beginWorldPass(SDL_Renderer* ren) {
+  const float s = resolution.scale();
+  if (s >= 0.999f || !SDL_RenderTargetSupported(ren)) return false;
+
+  if (!sceneTarget || sceneTargetW != viewportW || sceneTargetH != viewportH) {
+    textures::destroy(sceneTarget);
+    sceneTarget = textures::create(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                   viewportW, viewportH, "scene target");
+    if (!sceneTarget) return false;
+    SDL_SetTextureScaleMode(sceneTarget, SDL_ScaleModeLinear);
+    sceneTargetW = viewportW;
+    sceneTargetH = viewportH;
+  }
+
+  if (SDL_SetRenderTarget(ren, sceneTarget) != 0) return false;
+  SDL_RenderSetScale(ren, s, s);
+  return true;
+}
+
+void GameScene::endWorldPass(SDL_Renderer* ren, bool scaled) {
+  if (!scaled) return;
+
+  const float s = resolution.scale();
+  SDL_RenderSetScale(ren, 1.0f, 1.0f);
+  SDL_SetRenderTarget(ren, nullptr);
+
+  SDL_Rect src { 0, 0,
+                 std::min(sceneTargetW, (int)std::ceil(viewportW * s)),
+                 std::min(sceneTargetH, (int)std::ceil(viewportH * s)) };
+  SDL_RenderCopy(ren, sceneTarget, &src, nullptr);
 }
 
 void GameScene::onRendererChanged(SDL_Renderer* newRenderer) {
+  cpuCompositing = wantCpuCompositing(newRenderer);
   reloadTextures(newRenderer);
+  syncFrameBudget();
+}
+
+void GameScene::syncFrameBudget() {
+  int hz = 60;
+  SDL_DisplayMode mode;
+  SDL_Window* window = m_game ? m_game->window() : nullptr;
+  if (window && SDL_GetWindowDisplayMode(window, &mode) == 0 && mode.refresh_rate > 0) hz = mode.refresh_rate;
+  resolution.setTargetFrameMs(1000.0f / (float)hz);
 }
 
 void GameScene::syncViewportMetrics() {
@@ -699,11 +1143,12 @@ void GameScene::refreshZoomFromViewport(int viewportW, int viewportH) {
   screenGroundY = std::clamp(grounded, 0.0f, vh);
 }
 
-SDL_FRect GameScene::toScreenRect(const SDL_FRect& world) const {
-  SDL_FRect out{};
-  out.x = (world.x - camX) * zoomScale;
-  out.w = world.w * zoomScale;
-  out.h = world.h * zoomScale;
-  out.y = screenGroundY + (world.y - groundY) * zoomScale;
-  return out;
+zoom::Camera GameScene::worldCamera() const {
+  zoom::Camera c;
+  c.camX = camX;
+  c.zoom = zoomScale;
+  c.useAnchorY = true;
+  c.anchorWorldY = groundY;
+  c.anchorScreenY = screenGroundY;
+  return c;
 }
@@ -5,44 +5,90 @@
 #include <string>
 #include <vector>
 
+#include "Animation.h"
+#include "CpuCompositor.h"
+#include "DynamicResolution.h"
+#include "EcsWorld.h"
+#include "Ghost.h"
+#include "Level.h"
+#include "Particles.h"
+#include "Physics.h"
 #include "Scene.h"
+#include "Snapshot.h"
+#include "SpriteSheet.h"
+#include "Zoom.h"
 class Game;
 
-enum class ObstacleType { JumpOver, DuckUnder };
-
-struct Obstacle {
-  SDL_FRect rect{};
-  ObstacleType type{};
-};
-
-struct LevelDef {
-  float length = 4000.0f;
-  float bullSpeedBonus = 0.0f;
-  int obstacleCount = 12;
-  float obstacleSpacing = 260.0f;
-};
-
 class GameScene final : public Scene {
 public:
   explicit GameScene(Game* game);
   ~GameScene() override; // NOT default: we must destroy textures
 
   void handleEvent(const SDL_Event& e) override;
+  void handlePointer(const input::PointerEvent& p) override;
+  void handleGesture(const input::GestureEvent& g) override;
   void update(float dt) override;
   void render(SDL_Renderer* ren) override;
+  bool needsRedraw() const override { return !waitingForEnter; } // overlay is static
   void onRendererChanged(SDL_Renderer* newRenderer) override;
+  size_t obstacleCount() const override { return obstacles.size(); }
 
 private:
   void buildLevels();
   void startLevel(int idx);
   void restartLevel();
   void generateObstacles(const LevelDef& def);
+  bool loadLevelFile(int idx);
+  void pollLevelFileReload(float dt);
+  void saveCurrentLevelFile();
+  void spawnChasers(const LevelDef& def);
+
+  void captureSnapshot(SimSnapshot& out) const;
+  bool restoreSnapshot(const SimSnapshot& s);
+
+  // Floating origin (see originChunk).
+  double originX() const { return (double)originChunk * kOriginChunk; }
+  double absolutePlayerX() const { return originX() + player.box.x; }
+  void rebaseOrigin(int64_t chunk);
+  void maybeRebaseOrigin();
 
   void reloadTextures(SDL_Renderer* renderer);
 
-  void applyInput();
+  // Index of the sprite kind for `path`, loading it on first use.
+  uint16_t spriteKind(const char* path, SDL_Color fallback = SDL_Color{ 220, 220, 220, 255 });
 
-  bool intersects(const SDL_FRect& a, const SDL_FRect& b) const;
+  // World pass contents into worldDraws (see WorldDraw); the backends below
+  // only emit that list.
+  void buildWorldDraws();
+  void collectSprites(const zoom::Camera& cam, const SDL_FRect& view); // ECS sprites, grouped by kind
+  void pushSprite(uint16_t kind, int frame, const SDL_FRect& rect, bool flip = false, Uint8 alpha = 255);
+
+  // World pass at reduced resolution (HUD stays native).
+  bool beginWorldPass(SDL_Renderer* ren);
+  void endWorldPass(SDL_Renderer* ren, bool scaled);
+
+  // World (everything below the HUD) through SDL, or through the CPU
+  // compositor; the CPU path returns false if it could not present.
+  void renderWorldGpu(SDL_Renderer* ren);
+  bool renderWorldCpu(SDL_Renderer* ren);
+  ghost::Pose playerPose() const;
+  int playerFrame() const;
+
+  // Ghost of the best run on this level, kept per obstacle layout (a
+  // generated level gets a new layout, and so a new ghost, every session).
+  uint32_t layoutHash() const;
+  void loadGhost();
+  ghost::Sample ghostSample() const;
+  void restartGhostRecording();
+  void finishGhostRun();
+  bool ghostBox(SDL_FRect& box, int& frame, bool& flip); // world space, false when hidden
+
+  physics::PlayerTuning playerTuning() const;
+
+  void emitLandingDust();
+  void emitDuckPuff();
+  void emitBullDust(float dt);
+  void playBullSteps(float dt);
 
   void checkCaught();
   void checkGoalReached();
@@ -63,6 +109,15 @@ private:
   float camX = 0.0f;
   float goalX = 0.0f;
 
+  // Floating origin: every float position in this scene (player, bulls,
+  // camX, goalX, obstacles, particles) is relative to originChunk *
+  // kOriginChunk. Once the player is two chunks out, everything shifts
+  // back by whole chunks, so positions stay small and float-precise however
+  // far the run goes. Chunks are a power of two, which keeps the shift exact
+  // for everything ahead of the new origin.
+  static constexpr float kOriginChunk = 2048.0f;
+  int64_t originChunk = 0;
+
   // viewport + scaling state
   int viewportW = 960;
   int viewportH = 540;
@@ -80,30 +135,112 @@ private:
   std::string hudLevelText;
   std::string overlayText;
 
-  // player
-  SDL_FRect player{};
-  float vx = 0.0f;
-  float vy = 0.0f;
-  bool onGround = false;
-  bool ducking = false;
+  // player (box, velocity, ground/duck flags; stepped by physics::stepPlayer)
+  physics::PlayerState player;
 
-  // chaser
-  SDL_FRect bull{};
+  // chasers (lead bull + herd) live in the entity world
+  ecs::World world;
   float bullSpeed = 0.0f;
+  float bullW = 86.0f;
+  float bullH = 62.0f;
+  float herdSpacing = 70.0f;
 
   // obstacles
-  std::vector<Obstacle> obstacles;
+  std::vector<Obstacle> obstacles;           // origin-relative (what physics/render use)
+  std::vector<LevelObstacle> levelObstacles; // level space, as generated/loaded
+
+  // Generated layouts derive from this and the level index, so a level
+  // looks the same every session (saved ghosts stay valid).
+  uint32_t campaignSeed = 0;
 
-  // textures (sprite sheets + static textures)
-  SDL_Texture* texPlayerSheet = nullptr;
-  SDL_Texture* texBullSheet   = nullptr;
-  SDL_Texture* texBlock       = nullptr;
-  SDL_Texture* texBar         = nullptr;
-  SDL_Texture* texBg          = nullptr;
+  // authored layout for the current level (assets/levels/levelNN.blvl)
+  std::string levelFilePath;
+  long long levelFileMTime = 0;
+  float levelReloadPollT = 0.0f;
+
+  // snapshots: the level start (instant retry on the same layout) and the
+  // last few seconds of frames (hold R to rewind)
+  uint32_t layoutId = 0;
+  SimSnapshot levelStartSnapshot;
+  SnapshotRing history{ 60 * 5 };
+  bool rewindHeld = false;
+
+  // ghost racer: this run is recorded, the best one streams back
+  float runTime = 0.0f;
+  ghost::Recorder ghostRecorder;
+  ghost::Track ghostBest;
+  ghost::Player ghostPlayer;
+
+  // effects
+  ParticleSystem particles;
+  float bullDustT = 0.0f;
+  float bullStepT = 0.0f;
+
+  // Sprite kinds, one per .anim file (assets/sprites/*.anim) or static
+  // image: the clips, the trimmed sheet they index and its CPU copy.
+  // ecs::Sprite::sheet indexes this table, so a new character needs no new
+  // members here.
+  struct SpriteKind {
+    std::string path;
+    anim::AnimSet anim;
+    SDL_Color fallback{};  // drawn when the sheet failed to load
+    SpriteSheet sheet;
+    cpu::Atlas atlas;
+  };
+  std::vector<SpriteKind> spriteKinds;
+  uint16_t kindPlayer = 0;
+  uint16_t kindBull = 0;
+  uint16_t kindBlock = 0;
+  uint16_t kindBar = 0;
+
+  // clip ids resolved at load
+  int playerClipIdle = 0;
+  int playerClipRun = 0;
+  int playerClipJump = 0;
+  int playerClipDuck = 0;
+  int bullClipRun = 0;
+
+  // the opaque background
+  SDL_Texture* texBg = nullptr;
+  bool texturesLoaded = false; // reloadTextures ran with a renderer
+
+  // render scratch for batched world -> screen transforms (reused)
+  std::vector<SDL_FRect> screenRects;
+  std::vector<int> visibleIdx;
+  std::vector<int> spriteFrames;
+  std::vector<int> kindSprites;  // sprite indices of one kind
+  std::vector<int> kindRects;    // their screenRects slots
+
+  // One world-pass item, in draw order: a sprite frame, or a plain fill
+  // (kNoSheet, or when the kind's sheet is missing). color.a is the
+  // opacity either way.
+  static constexpr uint16_t kNoSheet = 0xFFFF;
+  struct WorldDraw {
+    SDL_FRect rect;              // screen space
+    uint16_t kind;
+    int frame;
+    bool flip;
+    SDL_Color color;
+  };
+  std::vector<WorldDraw> worldDraws;
+
+  // dynamic resolution: world is drawn into the top-left scale*size of a
+  // full-size target, then stretched to the window
+  ResolutionController resolution;
+  SDL_Texture* sceneTarget = nullptr;
+  int sceneTargetW = 0;
+  int sceneTargetH = 0;
+
+  // CPU compositing (GPU-less machines): on by default with the software
+  // renderer, GAME_CPU_RENDER=0/1 forces it, F3 toggles. Keeps CPU-side
+  // copies of the sheets; the HUD is still drawn through SDL.
+  bool cpuCompositing = false;
+  cpu::Canvas canvas;
+  cpu::Image cpuBg;
+  SDL_Texture* cpuTexture = nullptr;
 
   // animation timers
   float playerAnimT = 0.0f;
-  float bullAnimT   = 0.0f;
 
   // input (keyboard)
   bool leftHeld = false;
@@ -111,21 +248,13 @@ private:
   bool duckHeld = false;
   bool jumpPressed = false; // one-shot
 
-  // input (touch/mouse gestures) - additive, won't break keyboard
+  // input (touch/mouse, see handlePointer) - additive, won't break keyboard
   bool gestureActive = false;
-  bool gestureSwiped = false;
-
   bool touchRunHeld = false;
   bool touchDuckHeld = false;
 
-  float gestureStartX = 0.0f;
-  float gestureStartY = 0.0f;
-  float gestureCurX   = 0.0f;
-  float gestureCurY   = 0.0f;
-
-  float swipeThresholdPx = 48.0f; // also clamped to 0.08*screenH
-
   void syncViewportMetrics();
+  void syncFrameBudget(); // resolution target = one refresh of the window's display
   void refreshZoomFromViewport(int viewportW, int viewportH);
-  SDL_FRect toScreenRect(const SDL_FRect& world) const;
+  zoom::Camera worldCamera() const; // world -> screen, ground-anchored
 };
@@ -0,0 +1,293 @@
+// src/Ghost.cpp
+#include "Ghost.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "PrefPath.h"
+
+namespace ghost {
+
+static_assert(sizeof(GhostFileHeader) == 28, "ghost header layout changed");
+static_assert(sizeof(Keyframe) == 32, "ghost keyframe layout changed");
+
+namespace {
+
+// Tag byte: which fields follow. A tag with none of them set is a run of
+// (tag >> 3) + 1 samples that keep the current velocity and look.
+constexpr uint8_t kTagDx   = 1;
+constexpr uint8_t kTagDy   = 2;
+constexpr uint8_t kTagLook = 4;
+constexpr uint32_t kMaxRun = 32;
+
+void putVarint(std::vector<uint8_t>& out, int32_t v) {
+  uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); // zigzag
+  while (z >= 0x80) {
+    out.push_back((uint8_t)(z | 0x80));
+    z >>= 7;
+  }
+  out.push_back((uint8_t)z);
+}
+
+bool getVarint(const std::vector<uint8_t>& in, size_t& off, int32_t& v) {
+  uint32_t z = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (off >= in.size()) return false;
+    const uint8_t b = in[off++];
+    z |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      v = (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+// ---- recording -------------------------------------------------------------
+
+void Recorder::record(float time, const Sample& s) {
+  if (m_samples.empty()) {
+    m_samples.push_back(s);
+    m_last = s;
+    m_lastTime = time;
+    return;
+  }
+
+  // Resample onto the fixed ticks between the previous frame and this one,
+  // so frame-time jitter does not show up as velocity noise (which would
+  // break the delta runs).
+  const float span = time - m_lastTime;
+  for (size_t k = m_samples.size(); (float)k / (float)kSampleHz <= time; ++k) {
+    const float f = span > 0.0f ? std::clamp(((float)k / (float)kSampleHz - m_lastTime) / span, 0.0f, 1.0f) : 1.0f;
+    Sample t = s;
+    t.x = m_last.x + (int64_t)std::llround((double)(s.x - m_last.x) * f);
+    t.y = m_last.y + (int32_t)std::lround((double)(s.y - m_last.y) * f);
+    m_samples.push_back(t);
+  }
+  m_last = s;
+  m_lastTime = time;
+}
+
+void Recorder::truncate(float time) {
+  const size_t keep = (size_t)std::max(0.0f, time * (float)kSampleHz) + 1;
+  if (m_samples.size() > keep) m_samples.resize(keep);
+  if (!m_samples.empty()) {
+    m_last = m_samples.back();
+    m_lastTime = (float)(m_samples.size() - 1) / (float)kSampleHz;
+  }
+}
+
+Track Recorder::encode() const {
+  Track t;
+  t.sampleCount = (uint32_t)m_samples.size();
+  if (m_samples.empty()) return t;
+
+  const Sample& first = m_samples[0];
+  t.keys.push_back(Keyframe{ 0, 0, first.x, first.y, 0, 0, first.look, {} });
+
+  int32_t dx = 0, dy = 0;
+  uint32_t run = 0;
+  auto flushRun = [&] {
+    if (run) t.data.push_back((uint8_t)((run - 1) << 3));
+    run = 0;
+  };
+
+  for (size_t k = 1; k < m_samples.size(); ++k) {
+    const Sample& a = m_samples[k - 1];
+    const Sample& b = m_samples[k];
+    const int32_t ddx = (int32_t)(b.x - a.x) - dx; // per-sample steps fit 32 bits
+    const int32_t ddy = (b.y - a.y) - dy;
+    dx = (int32_t)(b.x - a.x);
+    dy = b.y - a.y;
+
+    const uint8_t tag = (uint8_t)((ddx ? kTagDx : 0) | (ddy ? kTagDy : 0) | (b.look != a.look ? kTagLook : 0));
+    if (tag == 0) {
+      if (++run == kMaxRun) flushRun();
+    } else {
+      flushRun();
+      t.data.push_back(tag);
+      if (ddx) putVarint(t.data, ddx);
+      if (ddy) putVarint(t.data, ddy);
+      if (tag & kTagLook) t.data.push_back(b.look);
+    }
+
+    // runs never cross a keyframe, so seeking can start decoding at one
+    if (k % kKeyInterval == 0) {
+      flushRun();
+      t.keys.push_back(Keyframe{ (uint32_t)k, (uint32_t)t.data.size(), b.x, b.y, dx, dy, b.look, {} });
+    }
+  }
+  flushRun();
+  return t;
+}
+
+// ---- playback --------------------------------------------------------------
+
+void Player::setTrack(const Track* track) {
+  m_track = (track && !track->empty()) ? track : nullptr;
+  if (m_track) seek(0);
+}
+
+void Player::seek(uint32_t sample) {
+  // start one sample early so m_prev is decoded too
+  const uint32_t from = sample ? sample - 1 : 0;
+  const std::vector<Keyframe>& keys = m_track->keys;
+  auto it = std::upper_bound(keys.begin(), keys.end(), from,
+                             [](uint32_t s, const Keyframe& k) { return s < k.sample; });
+  const Keyframe& k = (it == keys.begin()) ? keys.front() : *(it - 1);
+
+  m_index = k.sample;
+  m_offset = k.offset;
+  m_run = 0;
+  m_dx = k.dx;
+  m_dy = k.dy;
+  m_cur = Sample{ k.x, k.y, k.look };
+  m_prev = m_cur;
+
+  while (m_index < sample && step()) {}
+}
+
+bool Player::step() {
+  if (m_index + 1 >= m_track->sampleCount) return false;
+
+  uint8_t look = m_cur.look;
+  if (m_run == 0) {
+    const std::vector<uint8_t>& d = m_track->data;
+    if (m_offset >= d.size()) return false;
+    const uint8_t tag = d[m_offset++];
+
+    if ((tag & (kTagDx | kTagDy | kTagLook)) == 0) {
+      m_run = (uint32_t)(tag >> 3) + 1;
+    } else {
+      int32_t dd = 0;
+      if (tag & kTagDx) {
+        if (!getVarint(d, m_offset, dd)) return false;
+        m_dx += dd;
+      }
+      if (tag & kTagDy) {
+        if (!getVarint(d, m_offset, dd)) return false;
+        m_dy += dd;
+      }
+      if (tag & kTagLook) {
+        if (m_offset >= d.size()) return false;
+        look = d[m_offset++];
+      }
+      m_run = 1;
+    }
+  }
+
+  m_prev = m_cur;
+  m_cur.x += m_dx;
+  m_cur.y += m_dy;
+  m_cur.look = look;
+  --m_run;
+  ++m_index;
+  return true;
+}
+
+bool Player::sampleAt(float time, double& x, double& y, uint8_t& look) {
+  if (!m_track || time < 0.0f) return false;
+
+  const float pos = time * (float)kSampleHz;
+  const uint32_t i = (uint32_t)pos;
+  if (i >= m_track->sampleCount) return false;
+
+  // hold sample i in m_prev and i + 1 in m_cur (just i at the very end)
+  const uint32_t target = std::min(i + 1, m_track->sampleCount - 1);
+  if (target < m_index || target > m_index + (uint32_t)kKeyInterval) seek(target);
+  while (m_index < target && step()) {}
+
+  if (target == i) {
+    x = fromQuarter(m_cur.x);
+    y = fromQuarter(m_cur.y);
+    look = m_cur.look;
+    return true;
+  }
+
+  const double f = (double)(pos - (float)i);
+  x = fromQuarter((double)m_prev.x + (double)(m_cur.x - m_prev.x) * f);
+  y = fromQuarter(m_prev.y + (m_cur.y - m_prev.y) * f);
+  look = f < 0.5 ? m_prev.look : m_cur.look;
+  return true;
+}
+
+// ---- files -----------------------------------------------------------------
+
+bool save(const char* path, const Track& track, std::string& error) {
+  if (track.empty()) { error = "empty track"; return false; }
+  std::FILE* f = path ? std::fopen(path, "wb") : nullptr;
+  if (!f) { error = "cannot open for writing"; return false; }
+
+  GhostFileHeader h{};
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.version = kVersion;
+  h.headerSize = (uint16_t)sizeof(GhostFileHeader);
+  h.sampleHz = (uint16_t)kSampleHz;
+  h.keyInterval = (uint16_t)kKeyInterval;
+  h.sampleCount = track.sampleCount;
+  h.keyCount = (uint32_t)track.keys.size();
+  h.dataSize = (uint32_t)track.data.size();
+  h.layout = track.layout;
+
+  bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+  ok = ok && std::fwrite(track.keys.data(), sizeof(Keyframe), track.keys.size(), f) == track.keys.size();
+  if (ok && !track.data.empty()) ok = std::fwrite(track.data.data(), 1, track.data.size(), f) == track.data.size();
+  ok = (std::fclose(f) == 0) && ok;
+
+  if (!ok) error = "write failed";
+  return ok;
+}
+
+bool load(const char* path, Track& out, std::string& error) {
+  out = Track{};
+  std::FILE* f = path ? std::fopen(path, "rb") : nullptr;
+  if (!f) { error = "cannot open"; return false; }
+
+  GhostFileHeader h{};
+  bool ok = std::fread(&h, sizeof(h), 1, f) == 1;
+  if (!ok) error = "truncated header";
+  else if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) { error = "bad magic"; ok = false; }
+  else if (h.version != kVersion) { error = "unsupported version " + std::to_string(h.version); ok = false; }
+  else if (h.headerSize < sizeof(GhostFileHeader)) { error = "bad header size"; ok = false; }
+  else if (h.sampleHz != kSampleHz || h.keyInterval != kKeyInterval) { error = "different sample layout"; ok = false; }
+  else if (h.sampleCount == 0 || h.keyCount != (h.sampleCount - 1) / kKeyInterval + 1) { error = "bad keyframe count"; ok = false; }
+  else if (h.dataSize > h.sampleCount * 16u) { error = "bad data size"; ok = false; }
+
+  if (ok) {
+    std::fseek(f, (long)h.headerSize, SEEK_SET);
+    out.keys.resize(h.keyCount);
+    out.data.resize(h.dataSize);
+    ok = std::fread(out.keys.data(), sizeof(Keyframe), out.keys.size(), f) == out.keys.size() &&
+         (out.data.empty() || std::fread(out.data.data(), 1, out.data.size(), f) == out.data.size());
+    if (!ok) error = "short read";
+  }
+  std::fclose(f);
+
+  for (size_t i = 0; ok && i < out.keys.size(); ++i) {
+    const Keyframe& k = out.keys[i];
+    if (k.sample != (uint32_t)(i * kKeyInterval) || k.offset > h.dataSize) {
+      error = "bad keyframe " + std::to_string(i);
+      ok = false;
+    }
+  }
+
+  if (!ok) {
+    out = Track{};
+    return false;
+  }
+  out.sampleCount = h.sampleCount;
+  out.layout = h.layout;
+  return true;
+}
+
+std::string pathForLevel(int levelIndex) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "ghost_level%02d.bgst", levelIndex + 1);
+  return prefPath(name);
+}
+
+} // namespace ghost
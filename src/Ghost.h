@@ -0,0 +1,145 @@
+// src/Ghost.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Ghost runs: the player's trajectory sampled at a fixed rate, stored
+// compactly and played back next to the live player.
+//
+// Encoding, per sample after the first: a tag byte, then only the fields
+// it flags as changed. x/y are second-order deltas (change of per-sample
+// velocity) in quarter pixels, zigzag + LEB128 varints, so steady running
+// and gravity arcs cost a byte or less. Samples with nothing changed are
+// run-length coded in the tag. Every kKeyInterval samples a keyframe holds
+// the full decoder state, so playback can seek without decoding from the
+// start.
+//
+// Ghost file (.bgst), little-endian:
+//
+//   GhostFileHeader          28 bytes
+//   Keyframe[keyCount]       32 bytes each
+//   uint8_t[dataSize]        encoded samples
+namespace ghost {
+
+constexpr int kSampleHz = 60;
+constexpr int kKeyInterval = 128;
+
+constexpr char     kMagic[4] = { 'B', 'G', 'S', 'T' };
+constexpr uint16_t kVersion  = 3;
+
+enum class Pose : uint8_t { Idle, Run, Jump, Duck };
+
+// One recorded frame. Positions are level space (floating origin removed);
+// x is 64-bit so a run is exact at any distance.
+struct Sample {
+  int64_t x = 0;    // box left, quarter pixels
+  int32_t y = 0;    // box top, quarter pixels
+  uint8_t look = 0; // pose | flip << 2 | animation frame << 3
+
+  bool operator==(const Sample& o) const { return x == o.x && y == o.y && look == o.look; }
+};
+
+inline int64_t toQuarter(double v) { return (int64_t)(v * 4.0 + (v < 0.0 ? -0.5 : 0.5)); }
+inline double fromQuarter(double q) { return q * 0.25; }
+
+inline uint8_t makeLook(Pose pose, bool flip, int frame) {
+  return (uint8_t)((uint8_t)pose | (flip ? 4 : 0) | ((frame & 31) << 3));
+}
+inline Pose poseOf(uint8_t look) { return (Pose)(look & 3); }
+inline bool flipOf(uint8_t look) { return (look & 4) != 0; }
+inline int frameOf(uint8_t look) { return look >> 3; }
+
+struct GhostFileHeader {
+  char     magic[4];
+  uint16_t version;
+  uint16_t headerSize;      // offset of the keyframes
+  uint16_t sampleHz;
+  uint16_t keyInterval;
+  uint32_t sampleCount;
+  uint32_t keyCount;
+  uint32_t dataSize;
+  uint32_t layout;          // Track::layout
+};
+
+// Decoder state at `sample`; the next sample's bytes start at `offset`.
+struct Keyframe {
+  uint32_t sample;
+  uint32_t offset;
+  int64_t  x;
+  int32_t  y;
+  int32_t  dx, dy;          // per-sample velocity into `sample`
+  uint8_t  look;
+  uint8_t  pad[3];
+};
+
+struct Track {
+  uint32_t sampleCount = 0;
+  uint32_t layout = 0;      // hash of the obstacle layout the run was on
+  std::vector<Keyframe> keys;
+  std::vector<uint8_t> data;
+
+  bool empty() const { return sampleCount == 0 || keys.empty(); }
+  float duration() const { return (float)sampleCount / (float)kSampleHz; }
+  size_t bytes() const { return sizeof(GhostFileHeader) + keys.size() * sizeof(Keyframe) + data.size(); }
+};
+
+// Collects raw samples during a run (16 bytes each, appended in place);
+// encode() compresses them once, when the run ends.
+class Recorder {
+public:
+  void reset() { m_samples.clear(); }
+
+  // Adds the samples for every tick up to `time` (seconds since the run
+  // started), interpolated from the previous call, so variable frame
+  // times still give a fixed-rate track. The first call is tick 0.
+  void record(float time, const Sample& s);
+
+  // Drops everything recorded after `time` (rewind).
+  void truncate(float time);
+
+  int sampleCount() const { return (int)m_samples.size(); }
+  Track encode() const;
+
+private:
+  std::vector<Sample> m_samples;
+  Sample m_last;
+  float m_lastTime = 0.0f;
+};
+
+// Streams samples out of a track: a cursor decodes forward a sample or two
+// per frame and jumps through the nearest keyframe when time moves back
+// (rewind, restart) or far ahead.
+class Player {
+public:
+  // The track must outlive the player (or be replaced through here).
+  void setTrack(const Track* track);
+
+  // Position at `time` (interpolated between samples) and the look of
+  // the nearest sample. False without a track or past its end.
+  bool sampleAt(float time, double& x, double& y, uint8_t& look);
+
+private:
+  void seek(uint32_t sample);
+  bool step();
+
+  const Track* m_track = nullptr;
+  uint32_t m_index = 0;  // sample held in m_cur
+  size_t m_offset = 0;   // next byte to decode
+  uint32_t m_run = 0;    // unchanged samples left in the current run
+  int32_t m_dx = 0;
+  int32_t m_dy = 0;
+  Sample m_prev;
+  Sample m_cur;
+};
+
+// Writes / reads a track. On failure returns false and fills `error`.
+bool save(const char* path, const Track& track, std::string& error);
+bool load(const char* path, Track& out, std::string& error);
+
+// <pref path>/ghost_levelNN.bgst; empty when there is no writable pref path.
+std::string pathForLevel(int levelIndex);
+
+} // namespace ghost
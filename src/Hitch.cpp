@@ -0,0 +1,135 @@
+// src/Hitch.cpp
+#include "Hitch.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "Log.h"
+#include "PrefPath.h"
+
+namespace hitch {
+
+namespace {
+
+constexpr double kReportIntervalS = 5.0; // one bad stretch = one file
+constexpr int kMaxReports = 20;          // per session
+
+const char* const kPhaseNames[PhaseCount] = { "events", "display", "update", "render", "present", "post" };
+
+std::string reportPath() {
+  char name[64];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(name, sizeof(name), "hitch_%Y%m%d_%H%M%S.txt", std::localtime(&now));
+  return prefPath(name);
+}
+
+void appendf(std::string& out, const char* fmt, ...) {
+  char buf[256];
+  va_list ap;
+  va_start(ap, fmt);
+  const int n = std::vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  if (n > 0) out.append(buf, (size_t)std::min(n, (int)sizeof(buf) - 1));
+}
+
+void appendContext(std::string& out, const char* label, const Context& c) {
+  appendf(out, "%s: scene=%s pending=%s rendererDirty=%d obstacles=%zu textures=%d (%.1f MB)\n",
+          label, c.scene, c.pendingScene ? c.pendingScene : "none", c.rendererDirty ? 1 : 0,
+          c.obstacles, c.textures, c.textureBytes / 1048576.0);
+}
+
+} // namespace
+
+Detector::Detector() {
+  if (const char* env = std::getenv("GAME_HITCH_MS")) m_budgetMs = (float)std::atof(env);
+}
+
+Detector::~Detector() {
+  jobs::wait(m_writeJob);
+}
+
+void Detector::beginFrame() {
+  if (!enabled()) return;
+  m_cur = Frame{};
+  m_cur.index = m_frames;
+  m_last = SDL_GetPerformanceCounter();
+  m_open = true;
+}
+
+void Detector::mark(Phase p) {
+  if (!m_open) return;
+  const Uint64 now = SDL_GetPerformanceCounter();
+  m_cur.phaseMs[p] += (float)((now - m_last) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+  m_last = now;
+}
+
+bool Detector::endFrame(const Context& after) {
+  if (!m_open) return false;
+  m_open = false;
+
+  for (float ms : m_cur.phaseMs) m_cur.totalMs += ms;
+  m_ring[m_frames % kHistory] = m_cur;
+  ++m_frames;
+
+  if (m_cur.totalMs <= m_budgetMs) return false;
+
+  const Uint64 now = SDL_GetPerformanceCounter();
+  const double sinceLast = (now - m_lastReport) / (double)SDL_GetPerformanceFrequency();
+  if (m_reports >= kMaxReports || (m_reports > 0 && sinceLast < kReportIntervalS) || !m_writeJob.done()) {
+    LOG_WARN("Hitch: frame %llu took %.1f ms (report suppressed)",
+             (unsigned long long)m_cur.index, m_cur.totalMs);
+    return false;
+  }
+
+  m_lastReport = now;
+  ++m_reports;
+  report(m_cur, after);
+  return true;
+}
+
+void Detector::report(const Frame& slow, const Context& after) {
+  // Name the worst phase in the log line so the file is often not needed.
+  int worst = 0;
+  for (int p = 1; p < PhaseCount; ++p) {
+    if (slow.phaseMs[p] > slow.phaseMs[worst]) worst = p;
+  }
+
+  m_text.clear();
+  appendf(m_text, "hitch: frame %llu took %.2f ms (budget %.1f ms), mostly %s (%.2f ms)\n\n",
+          (unsigned long long)slow.index, slow.totalMs, m_budgetMs, kPhaseNames[worst], slow.phaseMs[worst]);
+  appendContext(m_text, "before", m_before);
+  appendContext(m_text, "after ", after);
+
+  appendf(m_text, "\n%8s %9s", "frame", "total");
+  for (const char* name : kPhaseNames) appendf(m_text, " %9s", name);
+  m_text += '\n';
+
+  const uint64_t first = m_frames > (uint64_t)kHistory ? m_frames - kHistory : 0;
+  for (uint64_t i = first; i < m_frames; ++i) {
+    const Frame& f = m_ring[i % kHistory];
+    appendf(m_text, "%8llu %9.2f", (unsigned long long)f.index, f.totalMs);
+    for (float ms : f.phaseMs) appendf(m_text, " %9.2f", ms);
+    appendf(m_text, "%s\n", f.totalMs > m_budgetMs ? "  <-- over budget" : "");
+  }
+
+  const std::string path = reportPath();
+  if (path.empty()) {
+    LOG_WARN("Hitch: frame %llu took %.1f ms in %s (no pref path for the report)",
+             (unsigned long long)slow.index, slow.totalMs, kPhaseNames[worst]);
+    return;
+  }
+  LOG_WARN("Hitch: frame %llu took %.1f ms, mostly %s; report: %s",
+           (unsigned long long)slow.index, slow.totalMs, kPhaseNames[worst], path.c_str());
+
+  jobs::run([this, path] {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return;
+    std::fwrite(m_text.data(), 1, m_text.size(), f);
+    std::fclose(f);
+  }, &m_writeJob);
+}
+
+} // namespace hitch
@@ -0,0 +1,81 @@
+// src/Hitch.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Jobs.h"
+
+// Hitch detector: per-phase timings of the last kHistory frames in a ring.
+// A frame slower than the budget writes that history, plus the game state
+// before and after the frame, to <pref path>/hitch_<date>_<time>.txt so a
+// long stall comes with an explanation.
+//
+// Off unless GAME_HITCH_MS sets a budget (e.g. 100): nothing prunes old
+// reports. Reports are rate-limited; the file is written on a job, not in
+// the frame.
+namespace hitch {
+
+enum Phase { Events, Display, Update, Render, Present, Post, PhaseCount };
+
+constexpr int kHistory = 120;
+
+// Cheap snapshot of what the game was doing (filled by Game).
+struct Context {
+  const char* scene = "?";
+  const char* pendingScene = nullptr; // null = no scene change queued
+  bool rendererDirty = false;
+  size_t obstacles = 0;
+  int textures = 0;
+  size_t textureBytes = 0;
+};
+
+struct Frame {
+  uint64_t index = 0;
+  float totalMs = 0.0f;
+  float phaseMs[PhaseCount] = {};
+};
+
+class Detector {
+public:
+  Detector();
+  ~Detector(); // waits for a report still being written
+  Detector(const Detector&) = delete;
+  Detector& operator=(const Detector&) = delete;
+
+  bool enabled() const { return m_budgetMs > 0.0f; }
+
+  // beginFrame() starts the clock, mark(p) charges the time since the
+  // previous mark to p. Marks outside begin/end (scripted stepFrame) are
+  // ignored.
+  void beginFrame();
+  void mark(Phase p);
+
+  // State as the frame starts its work (before scene changes / renderer
+  // rebuilds are applied).
+  void setBefore(const Context& c) { m_before = c; }
+
+  // Closes the frame; returns true if it was over budget and a report was
+  // queued.
+  bool endFrame(const Context& after);
+
+private:
+  void report(const Frame& slow, const Context& after);
+
+  float m_budgetMs = 0.0f;
+  Frame m_ring[kHistory];
+  uint64_t m_frames = 0;
+  Frame m_cur;
+  Uint64 m_last = 0;
+  bool m_open = false;
+  Context m_before;
+
+  Uint64 m_lastReport = 0;
+  int m_reports = 0;
+  std::string m_text; // handed to the writer job
+  jobs::Counter m_writeJob;
+};
+
+} // namespace hitch
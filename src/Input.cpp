@@ -0,0 +1,167 @@
+// src/Input.cpp
+#include "Input.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Scene.h"
+
+namespace input {
+
+void Router::setTargets(SDL_Window* window, SDL_Renderer* renderer) {
+  m_window = window;
+  m_renderer = renderer;
+  m_viewportValid = false;
+}
+
+void Router::refreshViewport() const {
+  int w = 0, h = 0;
+  if (m_renderer) SDL_GetRendererOutputSize(m_renderer, &w, &h);
+  m_outW = std::max(1, w);
+  m_outH = std::max(1, h);
+
+  // Offscreen renderers (tools) have no window: mouse == output pixels.
+  w = 0; h = 0;
+  if (m_window) SDL_GetWindowSize(m_window, &w, &h);
+  m_winW = w > 0 ? w : m_outW;
+  m_winH = h > 0 ? h : m_outH;
+
+  m_viewportValid = true;
+}
+
+void Router::viewportSize(int& w, int& h) const {
+  if (!m_renderer) { w = 0; h = 0; return; }
+  if (!m_viewportValid) refreshViewport();
+  w = m_outW;
+  h = m_outH;
+}
+
+PointerEvent Router::fromMouse(PointerAction action, int mx, int my) const {
+  if (!m_viewportValid) refreshViewport();
+  PointerEvent p;
+  p.action = action;
+  p.source = PointerSource::Mouse;
+  p.nx = (float)mx / (float)m_winW; // window points -> output pixels (high-DPI)
+  p.ny = (float)my / (float)m_winH;
+  p.x = p.nx * (float)m_outW;
+  p.y = p.ny * (float)m_outH;
+  return p;
+}
+
+PointerEvent Router::fromFinger(PointerAction action, const SDL_TouchFingerEvent& f) const {
+  if (!m_viewportValid) refreshViewport();
+  PointerEvent p;
+  p.action = action;
+  p.source = PointerSource::Touch;
+  p.id = (int64_t)f.fingerId;
+  p.nx = f.x; // tfinger is normalized 0..1
+  p.ny = f.y;
+  p.x = p.nx * (float)m_outW;
+  p.y = p.ny * (float)m_outH;
+  return p;
+}
+
+bool Router::feed(const SDL_Event& e, Scene* scene) {
+  const bool isMotion = e.type == SDL_MOUSEMOTION || e.type == SDL_FINGERMOTION;
+
+  // keep ordering: anything else sees the motion that came before it
+  if (!isMotion) flush(scene);
+
+  switch (e.type) {
+    case SDL_WINDOWEVENT:
+      if (e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) m_viewportValid = false;
+      return false;
+
+    case SDL_MOUSEMOTION:
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP: {
+      // touches also arrive as finger events; skip SDL's emulated mouse copy
+      const Uint32 which = e.type == SDL_MOUSEMOTION ? e.motion.which : e.button.which;
+      if (which == SDL_TOUCH_MOUSEID) return true;
+
+      if (e.type == SDL_MOUSEMOTION) {
+        const PointerEvent p = fromMouse(PointerAction::Move, e.motion.x, e.motion.y);
+        if (m_hasPendingMotion && m_pendingMotion.source != p.source) flush(scene);
+        m_pendingMotion = p;
+        m_hasPendingMotion = true;
+        ++m_motionIn;
+        return true;
+      }
+
+      if (e.button.button != SDL_BUTTON_LEFT) return true;
+      const PointerAction action = e.type == SDL_MOUSEBUTTONDOWN ? PointerAction::Down : PointerAction::Up;
+      dispatch(fromMouse(action, e.button.x, e.button.y), scene);
+      return true;
+    }
+
+    case SDL_FINGERMOTION: {
+      const PointerEvent p = fromFinger(PointerAction::Move, e.tfinger);
+      if (m_hasPendingMotion && (m_pendingMotion.source != p.source || m_pendingMotion.id != p.id)) {
+        flush(scene);
+      }
+      m_pendingMotion = p;
+      m_hasPendingMotion = true;
+      ++m_motionIn;
+      return true;
+    }
+
+    case SDL_FINGERDOWN:
+      dispatch(fromFinger(PointerAction::Down, e.tfinger), scene);
+      return true;
+
+    case SDL_FINGERUP:
+      dispatch(fromFinger(PointerAction::Up, e.tfinger), scene);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void Router::flush(Scene* scene) {
+  if (!m_hasPendingMotion) return;
+  m_hasPendingMotion = false;
+  ++m_motionOut;
+  dispatch(m_pendingMotion, scene);
+}
+
+void Router::reset() {
+  m_hasPendingMotion = false;
+  m_tracking = false;
+  m_swiped = false;
+}
+
+void Router::dispatch(const PointerEvent& p, Scene* scene) {
+  if (scene) scene->handlePointer(p);
+
+  switch (p.action) {
+    case PointerAction::Down:
+      m_tracking = true;
+      m_swiped = false;
+      m_trackId = p.id;
+      m_startX = p.x;
+      m_startY = p.y;
+      break;
+
+    case PointerAction::Move: {
+      if (!m_tracking || m_swiped || p.id != m_trackId) break;
+      const float dy = p.y - m_startY;
+      const float thresh = std::max(m_swipeMinPx, 0.08f * (float)m_outH);
+      if (std::fabs(dy) < thresh) break;
+
+      m_swiped = true;
+      GestureEvent g;
+      g.kind = dy < 0.0f ? GestureKind::SwipeUp : GestureKind::SwipeDown;
+      g.dx = p.x - m_startX;
+      g.dy = dy;
+      if (scene) scene->handleGesture(g);
+      break;
+    }
+
+    case PointerAction::Up:
+      if (p.id == m_trackId) m_tracking = false;
+      break;
+  }
+}
+
+} // namespace input
@@ -0,0 +1,88 @@
+// src/Input.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+class Scene;
+
+// Shared pointer input for all scenes. Mouse and touch arrive as one
+// PointerEvent in render-output pixels, so scenes never look at raw SDL
+// mouse/finger events or query the renderer themselves.
+namespace input {
+
+enum class PointerAction : uint8_t { Down, Move, Up };
+enum class PointerSource : uint8_t { Mouse, Touch };
+
+struct PointerEvent {
+  PointerAction action = PointerAction::Move;
+  PointerSource source = PointerSource::Mouse;
+  int64_t id = 0;       // finger id (0 for the mouse)
+  float x = 0.0f;       // render-output pixels
+  float y = 0.0f;
+  float nx = 0.0f;      // 0..1 across the output
+  float ny = 0.0f;
+};
+
+enum class GestureKind : uint8_t { SwipeUp, SwipeDown };
+
+// Fired once per press, when the pointer has travelled far enough
+// vertically since it went down.
+struct GestureEvent {
+  GestureKind kind = GestureKind::SwipeUp;
+  float dx = 0.0f;
+  float dy = 0.0f;
+};
+
+// Owned by Game. Caches the output/window size (refreshed only after
+// SDL_WINDOWEVENT_SIZE_CHANGED or a renderer change) and coalesces
+// mouse/finger motion to the latest sample per frame.
+class Router {
+public:
+  void setTargets(SDL_Window* window, SDL_Renderer* renderer);
+  void invalidateViewport() { m_viewportValid = false; }
+
+  // Cached SDL_GetRendererOutputSize.
+  void viewportSize(int& w, int& h) const;
+
+  // Returns true when the event was pointer input (delivered to `scene`
+  // now or at the next flush) and should not be forwarded raw.
+  bool feed(const SDL_Event& e, Scene* scene);
+
+  // Delivers coalesced motion; Game calls this once per frame.
+  void flush(Scene* scene);
+
+  // Drops pending motion and gesture tracking (scene switches).
+  void reset();
+
+  uint64_t motionReceived() const { return m_motionIn; }
+  uint64_t motionDelivered() const { return m_motionOut; }
+
+private:
+  void refreshViewport() const;
+  void dispatch(const PointerEvent& p, Scene* scene);
+  PointerEvent fromMouse(PointerAction action, int mx, int my) const;
+  PointerEvent fromFinger(PointerAction action, const SDL_TouchFingerEvent& f) const;
+
+  SDL_Window* m_window = nullptr;
+  SDL_Renderer* m_renderer = nullptr;
+
+  mutable bool m_viewportValid = false;
+  mutable int m_outW = 1, m_outH = 1;   // renderer output
+  mutable int m_winW = 1, m_winH = 1;   // window (mouse coordinates)
+
+  bool m_hasPendingMotion = false;
+  PointerEvent m_pendingMotion;
+
+  // gesture tracking for the pointer that went down last
+  bool m_tracking = false;
+  bool m_swiped = false;
+  int64_t m_trackId = 0;
+  float m_startX = 0.0f, m_startY = 0.0f;
+  float m_swipeMinPx = 48.0f;           // also at least 8% of output height
+
+  uint64_t m_motionIn = 0;
+  uint64_t m_motionOut = 0;
+};
+
+} // namespace input
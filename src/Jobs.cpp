@@ -0,0 +1,231 @@
+// src/Jobs.cpp
+#include "Jobs.h"
+
+#include <algorithm>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+  #include <chrono>
+  #include <condition_variable>
+  #include <deque>
+  #include <memory>
+  #include <mutex>
+  #include <string>
+  #include <thread>
+  #include <vector>
+  #define JOBS_THREADS 1
+#endif
+
+#include "Trace.h"
+
+namespace jobs {
+
+struct Job {
+  std::function<void()> fn;
+  Counter* counter = nullptr;
+};
+
+struct Continuation {
+  Job job;
+  Continuation* next = nullptr;
+};
+
+static void runNow(Job& job) {
+  job.fn();
+  if (job.counter) job.counter->release();
+}
+
+#ifdef JOBS_THREADS
+
+namespace {
+
+struct WorkQueue {
+  std::mutex mutex;
+  std::deque<Job> jobs;
+};
+
+struct Scheduler {
+  // [0] takes submissions from non-worker threads, [1..] belong to workers
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::vector<std::thread> threads;
+
+  std::atomic<int> queued{ 0 };
+  std::atomic<bool> quit{ false };
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+};
+
+Scheduler* gSched = nullptr;
+thread_local int tQueue = 0;
+
+void push(int q, Job&& job) {
+  WorkQueue& wq = *gSched->queues[(size_t)q];
+  {
+    std::lock_guard<std::mutex> lock(wq.mutex);
+    wq.jobs.push_back(std::move(job));
+  }
+  gSched->queued.fetch_add(1, std::memory_order_release);
+  gSched->wake.notify_one();
+}
+
+// Own queue from the back (LIFO, cache-warm), everyone else's from the
+// front (oldest first).
+bool take(int self, Job& out) {
+  const int n = (int)gSched->queues.size();
+  for (int k = 0; k < n; ++k) {
+    const int q = (self + k) % n;
+    WorkQueue& wq = *gSched->queues[(size_t)q];
+    std::lock_guard<std::mutex> lock(wq.mutex);
+    if (wq.jobs.empty()) continue;
+
+    if (k == 0 && self != 0) {
+      out = std::move(wq.jobs.back());
+      wq.jobs.pop_back();
+    } else {
+      out = std::move(wq.jobs.front());
+      wq.jobs.pop_front();
+    }
+    gSched->queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+// Runs one queued job. Returns false if there was none.
+bool runOne(int self) {
+  Job job;
+  if (!take(self, job)) return false;
+
+  runNow(job);
+  return true;
+}
+
+void workerMain(int index) {
+  tQueue = index;
+  const std::string name = "worker " + std::to_string(index);
+  trace::setThreadName(name.c_str());
+
+  while (!gSched->quit.load(std::memory_order_acquire)) {
+    if (runOne(index)) continue;
+
+    std::unique_lock<std::mutex> lock(gSched->sleepMutex);
+    gSched->wake.wait_for(lock, std::chrono::milliseconds(2), [] {
+      return gSched->quit.load(std::memory_order_acquire) ||
+             gSched->queued.load(std::memory_order_acquire) > 0;
+    });
+  }
+}
+
+} // namespace
+
+void init(int workers) {
+  if (gSched) return;
+  if (workers <= 0) workers = (int)std::thread::hardware_concurrency() - 1;
+  if (workers <= 0) return; // single core: inline is faster than a lone worker
+
+  gSched = new Scheduler();
+  for (int i = 0; i <= workers; ++i) gSched->queues.push_back(std::make_unique<WorkQueue>());
+  gSched->threads.reserve((size_t)workers);
+  for (int i = 1; i <= workers; ++i) gSched->threads.emplace_back(workerMain, i);
+}
+
+void shutdown() {
+  if (!gSched) return;
+
+  while (gSched->queued.load(std::memory_order_acquire) > 0) {
+    if (!runOne(tQueue)) std::this_thread::yield();
+  }
+
+  gSched->quit.store(true, std::memory_order_release);
+  gSched->wake.notify_all();
+  for (std::thread& t : gSched->threads) t.join();
+
+  delete gSched;
+  gSched = nullptr;
+}
+
+int workerCount() { return gSched ? (int)gSched->threads.size() : 0; }
+
+// Hands the job to the workers; false when jobs run inline.
+static bool enqueue(Job& job) {
+  if (!gSched) return false;
+  push(tQueue, std::move(job));
+  return true;
+}
+
+void wait(const Counter& counter) {
+  while (!counter.done()) {
+    if (!gSched || !runOne(tQueue)) std::this_thread::yield();
+  }
+}
+
+#else // no threads: everything runs inline on the caller
+
+void init(int) {}
+void shutdown() {}
+int workerCount() { return 0; }
+
+static bool enqueue(Job&) { return false; }
+
+void wait(const Counter&) {}
+
+#endif
+
+// Queues every job of a detached parked list (runs them inline without
+// workers).
+static void schedule(Continuation* list) {
+  while (list) {
+    Continuation* next = list->next;
+    if (!enqueue(list->job)) runNow(list->job);
+    delete list;
+    list = next;
+  }
+}
+
+void Counter::release() {
+  m_releasing.fetch_add(1, std::memory_order_seq_cst);
+  Continuation* ready = nullptr;
+  if (m_pending.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+    ready = m_parked.exchange(nullptr, std::memory_order_seq_cst);
+  }
+  m_releasing.fetch_sub(1, std::memory_order_seq_cst); // last touch of *this
+  schedule(ready);
+}
+
+void run(std::function<void()> fn, Counter* counter, const Counter* after) {
+  if (counter) counter->add();
+  Job job{ std::move(fn), counter };
+
+  if (after && !after->done()) {
+    Continuation* c = new Continuation{ std::move(job), nullptr };
+    c->next = after->m_parked.load(std::memory_order_relaxed);
+    while (!after->m_parked.compare_exchange_weak(c->next, c, std::memory_order_seq_cst)) {}
+
+    // The last release may have taken the list before c went on it; then
+    // whoever sees the count at zero first queues what is left. (Not
+    // done(): that stays false while the releaser is still finishing.)
+    if (after->m_pending.load(std::memory_order_seq_cst) == 0) {
+      schedule(after->m_parked.exchange(nullptr, std::memory_order_seq_cst));
+    }
+    return;
+  }
+
+  if (!enqueue(job)) runNow(job);
+}
+
+void parallelFor(int count, int grain, const std::function<void(int begin, int end)>& body) {
+  if (count <= 0) return;
+  grain = std::max(1, grain);
+  if (workerCount() == 0 || count <= grain) {
+    body(0, count);
+    return;
+  }
+
+  Counter done;
+  for (int begin = 0; begin < count; begin += grain) {
+    const int end = std::min(count, begin + grain);
+    run([&body, begin, end] { body(begin, end); }, &done);
+  }
+  wait(done);
+}
+
+} // namespace jobs
@@ -0,0 +1,79 @@
+// src/Jobs.h
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+// Work-stealing job system.
+//
+//   jobs::Counter done;
+//   for (...) jobs::run([=] { decode(i); }, &done);
+//   jobs::wait(done);                 // helps run jobs while it waits
+//
+//   jobs::run([=] { pack(); }, &packed, &done); // starts once `done` is
+//
+// A job with a dependency is parked on that counter, not queued: the
+// release that brings the counter to zero queues everything parked on it,
+// so nothing polls for readiness.
+//
+// Every worker owns a deque: it pushes/pops its own jobs at the back and
+// idle workers steal from the front of the others. Jobs submitted from a
+// non-worker thread (the main thread) go to a shared submission deque.
+//
+// Without init() (tools, Emscripten builds without pthreads) run() executes
+// the job inline, so callers never need a separate single-threaded path.
+namespace jobs {
+
+struct Continuation; // a job parked until a counter is done
+
+// Completion counter: run() adds one, the job's completion subtracts one.
+// Both are a few atomic ops (wait-free); waiters poll done(). Jobs parked
+// on it are linked into a lock-free stack and queued by the last release.
+// Do not re-arm (add to) a counter that still has jobs parked on it.
+class Counter {
+public:
+  Counter() = default;
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  void add(int n = 1) { m_pending.fetch_add(n, std::memory_order_relaxed); }
+  void release();
+
+  // Also false while a release is still handing off parked jobs, so a
+  // done counter can be destroyed right away.
+  bool done() const {
+    return m_pending.load(std::memory_order_seq_cst) == 0 &&
+           m_releasing.load(std::memory_order_seq_cst) == 0;
+  }
+
+private:
+  friend void run(std::function<void()> fn, Counter* counter, const Counter* after);
+
+  std::atomic<int> m_pending{ 0 };
+  std::atomic<int> m_releasing{ 0 };
+  mutable std::atomic<Continuation*> m_parked{ nullptr };
+};
+
+// Starts `workers` threads (<= 0: one per core, minus the calling thread).
+// Does nothing on builds without thread support.
+void init(int workers = 0);
+
+// Drains outstanding jobs and joins the workers.
+void shutdown();
+
+// Worker threads running (0 when jobs execute inline).
+int workerCount();
+
+// Queues `fn`. If `counter` is set it is bumped now and released when fn
+// returns. If `after` is set, fn is parked until `after` is done (callers
+// keep `after` alive until this returns).
+void run(std::function<void()> fn, Counter* counter = nullptr, const Counter* after = nullptr);
+
+// Returns once `counter` is done, executing queued jobs in the meantime.
+void wait(const Counter& counter);
+
+// Splits [0, count) into chunks of about `grain` items, runs body(begin,
+// end) on each across the workers and waits for all of them.
+void parallelFor(int count, int grain, const std::function<void(int begin, int end)>& body);
+
+} // namespace jobs
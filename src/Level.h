@@ -0,0 +1,35 @@
+// src/Level.h
+#pragma once
+
+#include <SDL2/SDL.h>
+
+enum class ObstacleType { JumpOver, DuckUnder };
+
+// Origin-relative obstacle: what collision, validation and drawing use.
+struct Obstacle {
+  SDL_FRect rect{};
+  ObstacleType type{};
+};
+
+// Level-space obstacle, as generated or loaded. x is double so positions
+// stay exact however long the level runs; the origin-relative Obstacle is
+// recomputed from it whenever the floating origin moves.
+struct LevelObstacle {
+  double x = 0.0;
+  float y = 0.0f;
+  float w = 0.0f;
+  float h = 0.0f;
+  ObstacleType type{};
+};
+
+inline Obstacle toLocal(const LevelObstacle& o, double originX) {
+  return Obstacle{ SDL_FRect{ (float)(o.x - originX), o.y, o.w, o.h }, o.type };
+}
+
+struct LevelDef {
+  double length = 4000.0; // level space, like LevelObstacle::x
+  float bullSpeedBonus = 0.0f;
+  int obstacleCount = 12;
+  float obstacleSpacing = 260.0f;
+  int chaserCount = 1; // lead bull + herd followers
+};
@@ -0,0 +1,228 @@
+// src/LevelFile.cpp
+#include "LevelFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sys/stat.h>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+  #define LEVELFILE_MMAP 1
+#endif
+
+namespace levelfile {
+
+// Records are handed out as LevelObstacle*, so the two layouts must agree.
+static_assert(sizeof(LevelFileHeader) == 40, "level header layout changed");
+static_assert(sizeof(LevelFileObstacle) == 24, "level record layout changed");
+static_assert(sizeof(LevelObstacle) == sizeof(LevelFileObstacle), "LevelObstacle must match LevelFileObstacle");
+static_assert(offsetof(LevelObstacle, y) == offsetof(LevelFileObstacle, y), "LevelObstacle must match LevelFileObstacle");
+static_assert(offsetof(LevelObstacle, type) == offsetof(LevelFileObstacle, type), "LevelObstacle must match LevelFileObstacle");
+static_assert(sizeof(ObstacleType) == sizeof(uint32_t), "ObstacleType must be 32-bit");
+static_assert(sizeof(LevelFileHeaderV1) == 32, "v1 level header layout changed");
+static_assert(sizeof(LevelFileObstacleV1) == 20, "v1 level record layout changed");
+
+static bool validRecord(double x, float y, float w, float h, uint32_t type) {
+  const bool finite = std::isfinite(x) && std::isfinite(y) && std::isfinite(w) && std::isfinite(h);
+  return finite && w > 0.0f && h > 0.0f && type <= (uint32_t)ObstacleType::DuckUnder;
+}
+
+LevelFile::~LevelFile() { close(); }
+
+void LevelFile::close() {
+#ifdef LEVELFILE_MMAP
+  if (m_mapped && m_base) munmap((void*)m_base, m_size);
+#endif
+  m_base = nullptr;
+  m_size = 0;
+  m_mapped = false;
+  m_buffer.clear();
+  m_buffer.shrink_to_fit();
+  m_upgraded.clear();
+  m_open = false;
+  m_def = LevelDef{};
+  m_obstacles = nullptr;
+  m_count = 0;
+}
+
+bool LevelFile::open(const char* path, std::string& error) {
+  close();
+  if (!path) { error = "null path"; return false; }
+
+#ifdef LEVELFILE_MMAP
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) { error = "cannot open"; return false; }
+
+  struct stat st{};
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    error = "cannot stat (or empty)";
+    return false;
+  }
+
+  void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) { error = "mmap failed"; return false; }
+
+  m_base = (const unsigned char*)p;
+  m_size = (size_t)st.st_size;
+  m_mapped = true;
+#else
+  std::FILE* f = std::fopen(path, "rb");
+  if (!f) { error = "cannot open"; return false; }
+
+  std::fseek(f, 0, SEEK_END);
+  long len = std::ftell(f);
+  std::fseek(f, 0, SEEK_SET);
+  if (len <= 0) { std::fclose(f); error = "empty file"; return false; }
+
+  m_buffer.resize((size_t)len);
+  const size_t got = std::fread(m_buffer.data(), 1, m_buffer.size(), f);
+  std::fclose(f);
+  if (got != m_buffer.size()) { m_buffer.clear(); error = "short read"; return false; }
+
+  m_base = m_buffer.data();
+  m_size = m_buffer.size();
+#endif
+
+  if (!validate(m_size, error)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool LevelFile::validate(size_t size, std::string& error) {
+  if (size < sizeof(LevelFileHeaderV1)) { error = "truncated header"; return false; }
+
+  const LevelFileHeader* h = (const LevelFileHeader*)m_base;
+  if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0) { error = "bad magic"; return false; }
+  if (h->version == 1) return validateV1(size, error);
+  if (h->version != kVersion) { error = "unsupported version " + std::to_string(h->version); return false; }
+  if (size < sizeof(LevelFileHeader)) { error = "truncated header"; return false; }
+  if (h->headerSize < sizeof(LevelFileHeader) || h->headerSize % 8 != 0) { error = "bad header size"; return false; }
+
+  if (!std::isfinite(h->length) || h->length <= 0.0 ||
+      !std::isfinite(h->bullSpeedBonus) || !std::isfinite(h->obstacleSpacing)) {
+    error = "bad level parameters";
+    return false;
+  }
+
+  // size check without overflow: records must fit in what follows the header
+  const size_t avail = size - std::min(size, (size_t)h->headerSize);
+  if (h->headerSize > size || (size_t)h->recordCount > avail / sizeof(LevelFileObstacle)) {
+    error = "obstacle records exceed file size";
+    return false;
+  }
+
+  const LevelFileObstacle* recs = (const LevelFileObstacle*)(m_base + h->headerSize);
+  for (uint32_t i = 0; i < h->recordCount; ++i) {
+    const LevelFileObstacle& r = recs[i];
+    if (!validRecord(r.x, r.y, r.w, r.h, r.type)) {
+      error = "bad obstacle record " + std::to_string(i);
+      return false;
+    }
+  }
+
+  m_def.length = h->length;
+  m_def.bullSpeedBonus = h->bullSpeedBonus;
+  m_def.obstacleSpacing = h->obstacleSpacing;
+  m_def.chaserCount = h->chaserCount > 0 ? h->chaserCount : 1;
+  m_obstacles = (const LevelObstacle*)recs;
+  m_count = h->recordCount;
+  m_open = true;
+  return true;
+}
+
+bool LevelFile::validateV1(size_t size, std::string& error) {
+  const LevelFileHeaderV1* h = (const LevelFileHeaderV1*)m_base;
+  if (h->headerSize < sizeof(LevelFileHeaderV1) || h->headerSize % 4 != 0) { error = "bad header size"; return false; }
+
+  if (!std::isfinite(h->length) || h->length <= 0.0f ||
+      !std::isfinite(h->bullSpeedBonus) || !std::isfinite(h->obstacleSpacing)) {
+    error = "bad level parameters";
+    return false;
+  }
+
+  const size_t avail = size - std::min(size, (size_t)h->headerSize);
+  if (h->headerSize > size || (size_t)h->recordCount > avail / sizeof(LevelFileObstacleV1)) {
+    error = "obstacle records exceed file size";
+    return false;
+  }
+
+  const LevelFileObstacleV1* recs = (const LevelFileObstacleV1*)(m_base + h->headerSize);
+  m_upgraded.reserve(h->recordCount);
+  for (uint32_t i = 0; i < h->recordCount; ++i) {
+    const LevelFileObstacleV1& r = recs[i];
+    if (!validRecord(r.x, r.y, r.w, r.h, r.type)) {
+      error = "bad obstacle record " + std::to_string(i);
+      return false;
+    }
+    m_upgraded.push_back(LevelObstacle{ r.x, r.y, r.w, r.h, (ObstacleType)r.type });
+  }
+
+  m_def.length = h->length;
+  m_def.bullSpeedBonus = h->bullSpeedBonus;
+  m_def.obstacleSpacing = h->obstacleSpacing;
+  m_def.chaserCount = h->chaserCount > 0 ? h->chaserCount : 1;
+  m_obstacles = m_upgraded.data();
+  m_count = m_upgraded.size();
+  m_open = true;
+  return true;
+}
+
+LevelDef LevelFile::def() const {
+  LevelDef d = m_def;
+  if (m_open) d.obstacleCount = (int)m_count;
+  return d;
+}
+
+bool save(const char* path, const LevelDef& def,
+          const std::vector<LevelObstacle>& obstacles, std::string& error) {
+  if (!path) { error = "null path"; return false; }
+
+  // assets/levels/ is not shipped: the first save creates it.
+  std::error_code ec;
+  const std::filesystem::path dir = std::filesystem::absolute(std::filesystem::path(path), ec).parent_path();
+  if (!dir.empty() && !std::filesystem::create_directories(dir, ec) && ec) {
+    error = "cannot create directory " + dir.string() + ": " + ec.message();
+    return false;
+  }
+
+  std::FILE* f = std::fopen(path, "wb");
+  if (!f) { error = "cannot open for writing in " + dir.string(); return false; }
+
+  LevelFileHeader h{};
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.version = kVersion;
+  h.headerSize = (uint16_t)sizeof(LevelFileHeader);
+  h.length = def.length;
+  h.bullSpeedBonus = def.bullSpeedBonus;
+  h.obstacleSpacing = def.obstacleSpacing;
+  h.obstacleCount = def.obstacleCount;
+  h.chaserCount = def.chaserCount;
+  h.recordCount = (uint32_t)obstacles.size();
+
+  bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+  if (ok && !obstacles.empty()) {
+    ok = std::fwrite(obstacles.data(), sizeof(LevelObstacle), obstacles.size(), f) == obstacles.size();
+  }
+  ok = (std::fclose(f) == 0) && ok;
+
+  if (!ok) error = "write failed";
+  return ok;
+}
+
+int64_t modifiedTime(const char* path) {
+  struct stat st{};
+  if (!path || stat(path, &st) != 0) return 0;
+  return (int64_t)st.st_mtime;
+}
+
+} // namespace levelfile
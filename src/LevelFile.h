@@ -0,0 +1,107 @@
+// src/LevelFile.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Level.h"
+
+// Binary level format (.blvl), little-endian:
+//
+//   LevelFileHeader                 40 bytes
+//   LevelFileObstacle[recordCount]  24 bytes each, same layout as LevelObstacle
+//
+// Readers must reject files whose version they do not know; new fields go
+// at the end of the header and bump both version and headerSize.
+//
+// Version 2 stores level-space x (length, obstacle x) as double. Version 1
+// files (float x) are still read, converted into an owned copy.
+namespace levelfile {
+
+constexpr char     kMagic[4] = { 'B', 'L', 'V', 'L' };
+constexpr uint16_t kVersion  = 2;
+
+struct LevelFileHeader {
+  char     magic[4];
+  uint16_t version;
+  uint16_t headerSize;      // offset of the obstacle records (multiple of 8)
+  double   length;
+  float    bullSpeedBonus;
+  float    obstacleSpacing;
+  int32_t  obstacleCount;   // LevelDef::obstacleCount (generator hint)
+  int32_t  chaserCount;
+  uint32_t recordCount;     // obstacle records that follow
+  uint32_t reserved;
+};
+
+struct LevelFileObstacle {
+  double   x;
+  float    y, w, h;
+  uint32_t type;            // ObstacleType
+};
+
+// Version 1 layouts.
+struct LevelFileHeaderV1 {
+  char     magic[4];
+  uint16_t version;
+  uint16_t headerSize;
+  float    length;
+  float    bullSpeedBonus;
+  float    obstacleSpacing;
+  int32_t  obstacleCount;
+  int32_t  chaserCount;
+  uint32_t recordCount;
+};
+
+struct LevelFileObstacleV1 {
+  float    x, y, w, h;
+  uint32_t type;
+};
+
+// Read-only view of a level file. The file is memory-mapped where the
+// platform allows it (read into one buffer otherwise) and current-version
+// obstacle records are handed out in place, without per-record parsing.
+class LevelFile {
+public:
+  LevelFile() = default;
+  ~LevelFile();
+  LevelFile(const LevelFile&) = delete;
+  LevelFile& operator=(const LevelFile&) = delete;
+
+  // Maps + validates. On failure returns false and fills `error`.
+  bool open(const char* path, std::string& error);
+  void close();
+
+  bool isOpen() const { return m_open; }
+  LevelDef def() const;
+
+  const LevelObstacle* obstacles() const { return m_obstacles; }
+  size_t obstacleCount() const { return m_count; }
+
+private:
+  bool validate(size_t size, std::string& error);
+  bool validateV1(size_t size, std::string& error);
+
+  const unsigned char* m_base = nullptr;
+  size_t m_size = 0;
+  bool m_mapped = false;
+  std::vector<unsigned char> m_buffer; // fallback when mmap is unavailable
+
+  bool m_open = false;
+  LevelDef m_def;
+  const LevelObstacle* m_obstacles = nullptr;
+  size_t m_count = 0;
+  std::vector<LevelObstacle> m_upgraded; // version 1 records, converted
+};
+
+// Writes the current version. Creates the parent directory if needed;
+// errors name the directory tried.
+bool save(const char* path, const LevelDef& def,
+          const std::vector<LevelObstacle>& obstacles, std::string& error);
+
+// Last-modified time of `path` (0 if it does not exist). Used for hot reload.
+int64_t modifiedTime(const char* path);
+
+} // namespace levelfile
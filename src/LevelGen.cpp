@@ -0,0 +1,66 @@
+// src/LevelGen.cpp
+#include "LevelGen.h"
+
+#include <algorithm>
+
+namespace levelgen {
+
+std::vector<LevelDef> campaign() {
+  std::vector<LevelDef> levels;
+  levels.reserve(10);
+
+  for (int i = 0; i < 10; ++i) {
+    LevelDef d;
+    d.length = 3200.0 + i * 450.0;
+    d.bullSpeedBonus = i * 18.0f;
+    d.obstacleCount = 10 + i * 2;
+    d.obstacleSpacing = std::max(170.0f, 270.0f - i * 9.0f);
+    d.chaserCount = 1 + i / 3;
+    levels.push_back(d);
+  }
+  return levels;
+}
+
+// xorshift32 (the state must never be zero)
+static float rand01(uint32_t& s) {
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return (float)(s >> 8) * (1.0f / 16777216.0f);
+}
+
+void generate(const LevelDef& def, float groundY, uint32_t seed, std::vector<LevelObstacle>& out) {
+  out.clear();
+  out.reserve(def.obstacleCount);
+
+  uint32_t rng = seed ? seed : 0x9E3779B9u;
+
+  double x = 520.0;
+  for (int i = 0; i < def.obstacleCount; ++i) {
+    float jitter = (rand01(rng) - 0.5f) * 120.0f;
+    x += def.obstacleSpacing + jitter;
+
+    LevelObstacle o;
+    bool makeDuck = (rand01(rng) < 0.45f);
+
+    if (makeDuck) {
+      // overhead bar
+      o.type = ObstacleType::DuckUnder;
+      o.w = 140.0f;
+      o.h = 24.0f;
+      o.x = x;
+      o.y = (groundY - 92.0f) + 22.0f;
+    } else {
+      // ground block (solid)
+      o.type = ObstacleType::JumpOver;
+      o.w = 58.0f;
+      o.h = 48.0f;
+      o.x = x;
+      o.y = groundY - o.h;
+    }
+
+    if (o.x < def.length - 220.0) out.push_back(o);
+  }
+}
+
+} // namespace levelgen
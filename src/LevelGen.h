@@ -0,0 +1,19 @@
+// src/LevelGen.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Level.h"
+
+// Procedural layouts. Generation is a pure function of (def, groundY, seed)
+// so a layout can be rebuilt, validated off-thread or shared by seed alone.
+namespace levelgen {
+
+// The built-in 10-level campaign.
+std::vector<LevelDef> campaign();
+
+// Jump blocks and duck bars along the track, in increasing x.
+void generate(const LevelDef& def, float groundY, uint32_t seed, std::vector<LevelObstacle>& out);
+
+} // namespace levelgen
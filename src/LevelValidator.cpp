@@ -0,0 +1,133 @@
+// src/LevelValidator.cpp
+#include "LevelValidator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+#include "Jobs.h"
+#include "LevelGen.h"
+
+namespace levelcheck {
+
+namespace {
+
+// Inputs tried from every state. Moving left is left out on purpose: the
+// bull only ever advances and the layout is static, so backing off never
+// opens a path that standing still doesn't.
+const physics::PlayerInput kChoices[] = {
+  { false, true,  false, false }, // run
+  { false, true,  false, true  }, // run + jump
+  { false, true,  true,  false }, // run + duck
+  { false, false, false, false }, // wait
+  { false, false, true,  false }, // duck in place
+  { false, false, false, true  }, // jump in place
+};
+
+uint64_t cellKey(const physics::PlayerState& s, const Limits& l) {
+  const uint64_t cx = (uint64_t)(int64_t)std::floor(s.box.x / l.cellX) & 0xFFFFFu;
+  const uint64_t cy = (uint64_t)(int64_t)std::floor(s.box.y / l.cellY) & 0xFFFFu;
+  const uint64_t cv = (uint64_t)(int64_t)std::floor(s.vy / l.cellVy) & 0xFFFFu;
+  return (cx << 34) | (cy << 18) | (cv << 2) |
+         ((uint64_t)s.onGround << 1) | (uint64_t)s.ducking;
+}
+
+} // namespace
+
+Result validate(const std::vector<Obstacle>& obstacles, const Scenario& sc, const Limits& limits) {
+  Result res;
+
+  // Sorted copy so each state only looks at obstacles near it.
+  std::vector<Obstacle> sorted(obstacles);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const Obstacle& a, const Obstacle& b) { return a.rect.x < b.rect.x; });
+  float widest = 0.0f;
+  for (const Obstacle& o : sorted) widest = std::max(widest, o.rect.w);
+
+  const float dt = limits.dt;
+  const float margin = widest + (std::abs(sc.tuning.moveSpeed) + 1.0f) * dt * 2.0f + 8.0f;
+
+  std::vector<physics::PlayerState> frontier{ sc.start };
+  std::vector<physics::PlayerState> next;
+  std::unordered_set<uint64_t> seen;
+  next.reserve((size_t)limits.maxFrontier * 6);
+  seen.reserve((size_t)limits.maxFrontier * 8);
+
+  SDL_FRect bull = sc.bull;
+  while (!frontier.empty()) {
+    ++res.steps;
+    bull.x += sc.bullSpeed * dt;
+
+    next.clear();
+    seen.clear();
+    for (const physics::PlayerState& from : frontier) {
+      const auto lo = std::lower_bound(sorted.begin(), sorted.end(), from.box.x - margin,
+                                       [](const Obstacle& o, float x) { return o.rect.x < x; });
+      const auto hi = std::lower_bound(lo, sorted.end(), from.box.x + from.box.w + margin,
+                                       [](const Obstacle& o, float x) { return o.rect.x < x; });
+      const Obstacle* near = sorted.data() + (lo - sorted.begin());
+      const size_t nearCount = (size_t)(hi - lo);
+
+      for (const physics::PlayerInput& in : kChoices) {
+        // jump/duck do nothing in the air; skip the duplicates
+        if ((in.jump || in.duck) && !from.onGround) continue;
+
+        physics::PlayerState s = from;
+        physics::stepPlayer(s, in, sc.tuning, near, nearCount, dt);
+        ++res.expanded;
+
+        if (s.box.x >= sc.goalX) {
+          res.solvable = true;
+          return res;
+        }
+        if (physics::overlaps(bull, s.box) || bull.x + bull.w >= s.box.x + sc.catchReach) continue; // caught
+        if (seen.insert(cellKey(s, limits)).second) next.push_back(s);
+      }
+    }
+
+    // Keep the states furthest ahead; anything far behind dies to the bull
+    // first anyway.
+    if ((int)next.size() > limits.maxFrontier) {
+      std::nth_element(next.begin(), next.begin() + limits.maxFrontier, next.end(),
+                       [](const physics::PlayerState& a, const physics::PlayerState& b) {
+                         return a.box.x > b.box.x;
+                       });
+      next.resize((size_t)limits.maxFrontier);
+    }
+    frontier.swap(next);
+  }
+  return res;
+}
+
+void validateSeeds(const LevelDef& def, const Scenario& sc,
+                   const std::vector<uint32_t>& seeds, std::vector<SeedResult>& out,
+                   const Limits& limits) {
+  out.assign(seeds.size(), SeedResult{});
+
+  // one layout per job: each takes milliseconds, far above scheduling cost
+  jobs::parallelFor((int)seeds.size(), 1, [&](int begin, int end) {
+    std::vector<LevelObstacle> generated;
+    std::vector<Obstacle> layout;
+    for (int i = begin; i < end; ++i) {
+      levelgen::generate(def, sc.tuning.groundY, seeds[(size_t)i], generated);
+      layout.clear();
+      for (const LevelObstacle& o : generated) layout.push_back(toLocal(o, 0.0));
+      const Result r = validate(layout, sc, limits);
+      out[(size_t)i].seed = seeds[(size_t)i];
+      out[(size_t)i].solvable = r.solvable;
+      out[(size_t)i].finishTime = r.solvable ? r.steps * limits.dt : 0.0f;
+    }
+  });
+}
+
+Scenario scenarioFor(const LevelDef& def) {
+  Scenario sc;
+  sc.start.box = { 120.0f, sc.tuning.groundY - sc.tuning.standHeight, 44.0f, sc.tuning.standHeight };
+  sc.start.onGround = true;
+  sc.goalX = (float)def.length;
+  sc.bull = { sc.start.box.x - 260.0f, sc.tuning.groundY - 62.0f, 86.0f, 62.0f };
+  sc.bullSpeed = 260.0f + def.bullSpeedBonus;
+  return sc;
+}
+
+} // namespace levelcheck
@@ -0,0 +1,65 @@
+// src/LevelValidator.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Level.h"
+#include "Physics.h"
+
+// Answers "can this layout be finished ahead of the bull?" by searching the
+// player's reachable states under the same stepPlayer() rules the game
+// uses. States are explored one fixed step at a time (breadth-first over
+// time) and de-duplicated on a coarse (x, y, vy, ground, duck) grid, so the
+// search stays bounded no matter how long the level is.
+//
+// A "solvable" verdict is exact: it was reached by a concrete input
+// sequence. Merging and the frontier cap can make the search miss a
+// razor-thin path, so "unsolvable" errs on the side of rejecting.
+namespace levelcheck {
+
+// Everything about a run that is not the layout itself.
+struct Scenario {
+  physics::PlayerTuning tuning;
+  physics::PlayerState start;   // player at level start
+  float goalX = 4000.0f;
+  SDL_FRect bull{ -140.0f, 398.0f, 86.0f, 62.0f }; // lead bull at t = 0
+  float bullSpeed = 260.0f;
+  float catchReach = 8.0f;      // same test as ecs::findCatchingChaser
+};
+
+struct Limits {
+  float dt = 1.0f / 60.0f;
+  float cellX = 4.0f;
+  float cellY = 4.0f;
+  float cellVy = 60.0f;
+  int maxFrontier = 64;         // furthest-ahead states kept per step
+};
+
+struct Result {
+  bool solvable = false;
+  int steps = 0;                // steps searched (to the goal when solvable)
+  uint64_t expanded = 0;        // player steps simulated
+};
+
+Result validate(const std::vector<Obstacle>& obstacles, const Scenario& sc,
+                const Limits& limits = Limits());
+
+struct SeedResult {
+  uint32_t seed = 0;
+  bool solvable = false;
+  float finishTime = 0.0f;      // earliest arrival at the goal (seconds)
+};
+
+// Generates + validates one layout per seed, spread over the job system's
+// workers. out[i] belongs to seeds[i].
+void validateSeeds(const LevelDef& def, const Scenario& sc,
+                   const std::vector<uint32_t>& seeds, std::vector<SeedResult>& out,
+                   const Limits& limits = Limits());
+
+// Default tuning placed like GameScene::startLevel (player at x=120, lead
+// bull 260 behind it) for offline tools; the game builds its own Scenario
+// from the live level state.
+Scenario scenarioFor(const LevelDef& def);
+
+} // namespace levelcheck
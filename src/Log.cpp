@@ -0,0 +1,246 @@
+// src/Log.cpp
+#include "Log.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+  #include <chrono>
+  #include <thread>
+  #define LOG_THREADS 1
+#endif
+
+namespace logging {
+
+namespace detail {
+
+namespace {
+
+constexpr size_t kQueueSize = 1024; // power of two (~256 KB of entries)
+#ifndef LOG_THREADS
+constexpr int kPumpLines = 32;
+#endif
+
+// Bounded multi-producer queue (Vyukov): each cell's sequence number says
+// whether it is free for the producer at `pos` or filled for the consumer.
+struct Cell {
+  std::atomic<size_t> seq;
+  Entry entry;
+};
+
+struct State {
+  std::vector<Cell> cells;
+  std::atomic<size_t> enqueuePos{ 0 };
+  size_t dequeuePos = 0; // consumer only
+  std::atomic<uint64_t> dropped{ 0 };
+  uint64_t droppedReported = 0;
+  std::atomic<bool> running{ false };
+  std::string line; // consumer scratch
+
+#ifdef LOG_THREADS
+  std::thread writer;
+#endif
+};
+
+State g;
+
+bool tryPush(const Entry& e) {
+  size_t pos = g.enqueuePos.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& c = g.cells[pos & (kQueueSize - 1)];
+    const size_t seq = c.seq.load(std::memory_order_acquire);
+    const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+    if (diff == 0) {
+      if (g.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        c.entry = e;
+        c.seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false; // full
+    } else {
+      pos = g.enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool tryPop(Entry& out) {
+  Cell& c = g.cells[g.dequeuePos & (kQueueSize - 1)];
+  if (c.seq.load(std::memory_order_acquire) != g.dequeuePos + 1) return false;
+  out = c.entry;
+  c.seq.store(g.dequeuePos + kQueueSize, std::memory_order_release);
+  ++g.dequeuePos;
+  return true;
+}
+
+const char* prefix(Level l) {
+  switch (l) {
+    case Level::Debug: return "[debug] ";
+    case Level::Warn:  return "[warn] ";
+    case Level::Error: return "[error] ";
+    default:           return "";
+  }
+}
+
+void appendf(std::string& out, const char* spec, ...) {
+  char buf[256];
+  va_list ap;
+  va_start(ap, spec);
+  const int n = std::vsnprintf(buf, sizeof(buf), spec, ap);
+  va_end(ap);
+  if (n > 0) out.append(buf, (size_t)n < sizeof(buf) ? (size_t)n : sizeof(buf) - 1);
+}
+
+// printf with the captured arguments: each conversion is re-issued on its
+// own with the length modifier normalized to what the argument was stored
+// as, so %d / %zu / %lld all work whatever integer type was passed.
+void format(const Entry& e, std::string& out) {
+  out.assign(prefix(e.level));
+  int next = 0;
+
+  for (const char* p = e.fmt; *p; ++p) {
+    if (*p != '%') { out.push_back(*p); continue; }
+    if (p[1] == '%') { out.push_back('%'); ++p; continue; }
+
+    // %[flags][width][.precision][length]conversion
+    char spec[32] = "%";
+    size_t n = 1;
+    const char* q = p + 1;
+    while (*q && std::strchr("-+ #0", *q) && n < 16) spec[n++] = *q++;
+    while (*q >= '0' && *q <= '9' && n < 20) spec[n++] = *q++;
+    if (*q == '.') {
+      spec[n++] = *q++;
+      while (*q >= '0' && *q <= '9' && n < 26) spec[n++] = *q++;
+    }
+    while (*q && std::strchr("hljztLq", *q)) ++q;
+    const char conv = *q;
+    if (!conv) break;
+    p = q;
+
+    if (next >= e.argc) { out += "(missing)"; continue; }
+    const Arg& a = e.args[next++];
+    const double asDouble = a.type == Arg::Double ? a.d : a.type == Arg::Int ? (double)a.i : (double)a.u;
+    const long long asInt = a.type == Arg::Double ? (long long)a.d : (long long)a.i;
+
+    switch (conv) {
+      case 'd': case 'i':
+        spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conv; spec[n] = '\0';
+        appendf(out, spec, asInt);
+        break;
+      case 'u': case 'x': case 'X': case 'o':
+        spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conv; spec[n] = '\0';
+        appendf(out, spec, (unsigned long long)asInt);
+        break;
+      case 'c':
+        spec[n++] = 'c'; spec[n] = '\0';
+        appendf(out, spec, (int)asInt);
+        break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        spec[n++] = conv; spec[n] = '\0';
+        appendf(out, spec, asDouble);
+        break;
+      case 's':
+        spec[n++] = 's'; spec[n] = '\0';
+        appendf(out, spec, a.type == Arg::Str ? e.text + a.str : "(?)");
+        break;
+      case 'p':
+        appendf(out, "%p", a.type == Arg::Ptr ? a.p : nullptr);
+        break;
+      default:
+        out += "(?)";
+        break;
+    }
+  }
+
+  if (out.empty() || out.back() != '\n') out.push_back('\n');
+}
+
+void emit(const Entry& e) {
+  format(e, g.line);
+  std::fwrite(g.line.data(), 1, g.line.size(), stdout);
+}
+
+// Consumer: formats up to `limit` queued entries. Returns how many.
+int drain(int limit) {
+  Entry e;
+  int done = 0;
+  while (done < limit && tryPop(e)) {
+    emit(e);
+    ++done;
+  }
+
+  const uint64_t dropped = g.dropped.load(std::memory_order_relaxed);
+  if (dropped != g.droppedReported) {
+    std::printf("[warn] log queue full: %llu message(s) dropped\n",
+                (unsigned long long)(dropped - g.droppedReported));
+    g.droppedReported = dropped;
+  }
+  if (done) std::fflush(stdout);
+  return done;
+}
+
+#ifdef LOG_THREADS
+void writerMain() {
+  while (g.running.load(std::memory_order_acquire)) {
+    if (drain(256) == 0) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  drain(1 << 30);
+}
+#endif
+
+} // namespace
+
+void submit(const Entry& e) {
+  if (!g.running.load(std::memory_order_acquire)) {
+    // no consumer yet (or any more): print on the spot
+    std::string line;
+    format(e, line);
+    std::fwrite(line.data(), 1, line.size(), stdout);
+    return;
+  }
+  if (!tryPush(e)) g.dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+using namespace detail;
+
+bool init() {
+  if (g.running.load(std::memory_order_acquire)) return true;
+
+  g.cells = std::vector<Cell>(kQueueSize);
+  for (size_t i = 0; i < kQueueSize; ++i) g.cells[i].seq.store(i, std::memory_order_relaxed);
+  g.enqueuePos.store(0, std::memory_order_relaxed);
+  g.dequeuePos = 0;
+
+  g.running.store(true, std::memory_order_release);
+#ifdef LOG_THREADS
+  g.writer = std::thread(writerMain);
+#endif
+  return true;
+}
+
+void shutdown() {
+  if (!g.running.load(std::memory_order_acquire)) return;
+  g.running.store(false, std::memory_order_release);
+#ifdef LOG_THREADS
+  if (g.writer.joinable()) g.writer.join();
+#else
+  drain(1 << 30);
+#endif
+}
+
+void pump() {
+#ifndef LOG_THREADS
+  if (g.running.load(std::memory_order_acquire)) drain(kPumpLines);
+#endif
+}
+
+uint64_t dropped() { return g.dropped.load(std::memory_order_relaxed); }
+
+} // namespace logging
@@ -0,0 +1,122 @@
+// src/Log.h
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Non-blocking logging.
+//
+//   LOG_ERROR("IMG_Load failed (%s): %s", path, IMG_GetError());
+//
+// The calling thread only captures the format string (must be a literal,
+// it is kept by pointer) and the arguments (strings are copied) into a
+// fixed-size entry and pushes it onto a bounded lock-free queue. A
+// background thread does the printf-style formatting and writes to stdout.
+// If the queue is full the message is dropped and counted, so an error
+// burst never stalls a frame. Single-threaded web builds format from
+// pump(), a few lines per frame.
+//
+// Levels below GAME_LOG_MIN_LEVEL (CMake: -DGAME_LOG_LEVEL=debug|info|
+// warn|error|off) compile to nothing. Before init() and after shutdown()
+// messages are formatted and printed immediately.
+#ifndef GAME_LOG_MIN_LEVEL
+  #define GAME_LOG_MIN_LEVEL 1
+#endif
+
+namespace logging {
+
+enum class Level : uint8_t { Debug, Info, Warn, Error };
+
+bool init();
+void shutdown(); // writes out everything still queued
+void pump();     // no-op when a writer thread is running
+
+uint64_t dropped();
+
+namespace detail {
+
+constexpr int kMaxArgs = 8;
+constexpr int kTextBytes = 168; // copied string arguments, all together
+
+struct Arg {
+  enum Type : uint8_t { Int, UInt, Double, Str, Ptr } type;
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+    const void* p;
+    uint16_t str; // offset into Entry::text
+  };
+};
+
+struct Entry {
+  const char* fmt;
+  Level level;
+  uint8_t argc;
+  uint16_t textUsed;
+  Arg args[kMaxArgs];
+  char text[kTextBytes];
+};
+
+void submit(const Entry& e);
+
+inline void packString(Entry& e, const char* s, size_t n) {
+  Arg& a = e.args[e.argc++];
+  a.type = Arg::Str;
+  a.str = e.textUsed;
+  const size_t room = (size_t)(kTextBytes - e.textUsed) - 1;
+  if (n > room) n = room; // truncated, still terminated
+  std::memcpy(e.text + e.textUsed, s, n);
+  e.text[e.textUsed + n] = '\0';
+  e.textUsed = (uint16_t)(e.textUsed + n + 1 < kTextBytes ? e.textUsed + n + 1 : kTextBytes - 1);
+}
+
+inline void pack(Entry& e, const char* s) { if (!s) s = "(null)"; packString(e, s, std::strlen(s)); }
+inline void pack(Entry& e, char* s) { pack(e, (const char*)s); }
+inline void pack(Entry& e, const std::string& s) { packString(e, s.data(), s.size()); }
+
+template <class T>
+void pack(Entry& e, T v) {
+  Arg& a = e.args[e.argc++];
+  if constexpr (std::is_floating_point<T>::value) {
+    a.type = Arg::Double;
+    a.d = (double)v;
+  } else if constexpr (std::is_pointer<T>::value) {
+    a.type = Arg::Ptr;
+    a.p = (const void*)v;
+  } else if constexpr (std::is_signed<T>::value || std::is_enum<T>::value) {
+    a.type = Arg::Int;
+    a.i = (int64_t)v;
+  } else {
+    static_assert(std::is_integral<T>::value, "unsupported log argument type");
+    a.type = Arg::UInt;
+    a.u = (uint64_t)v;
+  }
+}
+
+template <class... Args>
+void write(Level level, const char* fmt, const Args&... args) {
+  static_assert(sizeof...(Args) <= kMaxArgs, "too many log arguments");
+  Entry e;
+  e.fmt = fmt;
+  e.level = level;
+  e.argc = 0;
+  e.textUsed = 0;
+  (pack(e, args), ...);
+  submit(e);
+}
+
+} // namespace detail
+} // namespace logging
+
+#define LOG_AT(level, ...) \
+  do { \
+    if ((int)(level) >= GAME_LOG_MIN_LEVEL) ::logging::detail::write((level), __VA_ARGS__); \
+  } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(::logging::Level::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(::logging::Level::Info, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(::logging::Level::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(::logging::Level::Error, __VA_ARGS__)
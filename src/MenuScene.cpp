@@ -6,52 +6,10 @@
 
 #include "Game.h"
 #include "Text.h" // drawTextCentered(...)
+#include "Trace.h"
 
 namespace {
 
-bool isPointerDownEvent(const SDL_Event& e) {
-  return e.type == SDL_FINGERDOWN ||
-         (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT);
-}
-
-bool isPointerUpEvent(const SDL_Event& e) {
-  return e.type == SDL_FINGERUP ||
-         (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT);
-}
-
-bool isPointerMotionEvent(const SDL_Event& e) {
-  return e.type == SDL_FINGERMOTION || e.type == SDL_MOUSEMOTION;
-}
-
-bool extractPointerPosition(const SDL_Event& e, int rw, int rh, float& outX, float& outY) {
-  if (rw <= 0) rw = 1;
-  if (rh <= 0) rh = 1;
-
-  switch (e.type) {
-    case SDL_FINGERDOWN:
-    case SDL_FINGERMOTION:
-    case SDL_FINGERUP:
-      outX = e.tfinger.x * (float)rw;
-      outY = e.tfinger.y * (float)rh;
-      return true;
-
-    case SDL_MOUSEBUTTONDOWN:
-    case SDL_MOUSEBUTTONUP:
-      outX = (float)e.button.x;
-      outY = (float)e.button.y;
-      return true;
-
-    case SDL_MOUSEMOTION:
-      outX = (float)e.motion.x;
-      outY = (float)e.motion.y;
-      return true;
-
-    default:
-      break;
-  }
-  return false;
-}
-
 bool contains(const SDL_FRect& r, float px, float py) {
   return (px >= r.x && px <= r.x + r.w && py >= r.y && py <= r.y + r.h);
 }
@@ -69,13 +27,19 @@ static constexpr int MENU_COUNT = (int)(sizeof(MENU) / sizeof(MENU[0]));
 
 MenuScene::MenuScene(Game* game) : m_game(game) {}
 
+// Seconds the highlight keeps pulsing after the last input; then it rests
+// at full brightness and the menu stops asking for frames.
+static constexpr float PULSE_SECONDS = 5.0f;
+
 float MenuScene::pulse() const {
   // 0..1 pulse
-  return 0.5f + 0.5f * SDL_sinf((float)SDL_GetTicks() * 0.008f);
+  if (!m_pulsing) return 1.0f;
+  return 0.5f + 0.5f * SDL_sinf(m_time * 8.0f);
 }
 
 void MenuScene::handleEvent(const SDL_Event& e) {
   if (!m_game) return;
+  if (e.type == SDL_KEYDOWN) m_lastInputTime = m_time;
 
   if (e.type == SDL_KEYDOWN && e.key.repeat == 0) {
     switch (e.key.keysym.sym) {
@@ -98,20 +62,18 @@ void MenuScene::handleEvent(const SDL_Event& e) {
         break;
     }
   }
+}
 
-  const bool pointerDown = isPointerDownEvent(e);
-  const bool pointerUp = isPointerUpEvent(e);
-  const bool pointerMotion = isPointerMotionEvent(e);
-
-  if (pointerDown || pointerUp || pointerMotion) {
-    int rw = 0, rh = 0;
-    m_game->getRenderSize(rw, rh);
+void MenuScene::handlePointer(const input::PointerEvent& p) {
+  if (!m_game) return;
+  m_lastInputTime = m_time;
 
-    float px = 0.0f, py = 0.0f;
-    if (!extractPointerPosition(e, rw, rh, px, py)) return;
+  int rw = 0, rh = 0;
+  m_game->getRenderSize(rw, rh);
+  const int hit = hitTestItem(p.x, p.y, rw, rh);
 
-    if (pointerDown) {
-      int hit = hitTestItem(px, py, rw, rh);
+  switch (p.action) {
+    case input::PointerAction::Down:
       if (hit >= 0) {
         m_index = hit;
         m_pointerDown = true;
@@ -120,32 +82,34 @@ void MenuScene::handleEvent(const SDL_Event& e) {
         m_pointerDown = false;
         m_pointerIndex = -1;
       }
-    }
+      break;
 
-    if (pointerMotion) {
-      int hit = hitTestItem(px, py, rw, rh);
+    case input::PointerAction::Move:
       if (hit >= 0) {
         m_index = hit;
         if (m_pointerDown) m_pointerIndex = hit;
       }
-    }
+      break;
 
-    if (pointerUp) {
-      int hit = hitTestItem(px, py, rw, rh);
+    case input::PointerAction::Up:
       if (m_pointerDown && hit >= 0 && hit == m_pointerIndex) {
         activateSelection(hit);
       }
       m_pointerDown = false;
       m_pointerIndex = -1;
-    }
+      break;
   }
 }
 
-void MenuScene::update(float) {
-  // nothing yet (pulse is time-based via SDL_GetTicks)
+void MenuScene::update(float dt) {
+  TRACE_SCOPE("MenuScene::update");
+  // scene-local clock so pulse is reproducible under a fixed dt
+  m_time += dt;
+  m_pulsing = (m_time - m_lastInputTime) < PULSE_SECONDS;
 }
 
 void MenuScene::render(SDL_Renderer* r) {
+  TRACE_SCOPE("MenuScene::render");
   if (!m_game || !r) return;
 
   int w = 0, h = 0;
@@ -13,14 +13,19 @@ public:
   explicit MenuScene(Game* game);
 
   void handleEvent(const SDL_Event& e) override;
+  void handlePointer(const input::PointerEvent& p) override;
   void update(float dt) override;
   void render(SDL_Renderer* r) override;
+  bool needsRedraw() const override { return m_pulsing; }
 
 private:
   Game* m_game = nullptr; // not owned
   int   m_index = 0;
   bool  m_pointerDown = false;
   int   m_pointerIndex = -1;
+  float m_time = 0.0f;  // seconds since the scene opened (drives pulse)
+  float m_lastInputTime = 0.0f;
+  bool  m_pulsing = true; // highlight animates for a while after input
 
   float pulse() const; // simple highlight animation
   void activateSelection(int idx);
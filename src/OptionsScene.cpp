@@ -5,45 +5,10 @@
 #include <cstdio>
 
 #include "Text.h"
+#include "Trace.h"
 
 namespace {
 
-bool isPointerDownEvent(const SDL_Event& e) {
-  return e.type == SDL_FINGERDOWN ||
-         (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT);
-}
-
-bool isPointerUpEvent(const SDL_Event& e) {
-  return e.type == SDL_FINGERUP ||
-         (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT);
-}
-
-bool extractPointerPosition(const SDL_Event& e, int rw, int rh, float& outX, float& outY) {
-  if (rw <= 0) rw = 1;
-  if (rh <= 0) rh = 1;
-
-  switch (e.type) {
-    case SDL_FINGERDOWN:
-    case SDL_FINGERMOTION:
-    case SDL_FINGERUP:
-      outX = e.tfinger.x * (float)rw;
-      outY = e.tfinger.y * (float)rh;
-      return true;
-    case SDL_MOUSEBUTTONDOWN:
-    case SDL_MOUSEBUTTONUP:
-      outX = (float)e.button.x;
-      outY = (float)e.button.y;
-      return true;
-    case SDL_MOUSEMOTION:
-      outX = (float)e.motion.x;
-      outY = (float)e.motion.y;
-      return true;
-    default:
-      break;
-  }
-  return false;
-}
-
 bool contains(const SDL_FRect& r, float px, float py) {
   return (px >= r.x && px <= r.x + r.w && py >= r.y && py <= r.y + r.h);
 }
@@ -124,15 +89,15 @@ void OptionsScene::handleEvent(const SDL_Event& e) {
         break;
     }
   }
-
-  handlePointerEvent(e);
 }
 
 void OptionsScene::update(float) {
+  TRACE_SCOPE("OptionsScene::update");
   // nothing yet
 }
 
 void OptionsScene::render(SDL_Renderer* r) {
+  TRACE_SCOPE("OptionsScene::render");
   if (!m_game || !r) return;
 
   int w = 0, h = 0;
@@ -172,35 +137,24 @@ void OptionsScene::render(SDL_Renderer* r) {
   drawTextCentered(r, m_game->font(), "Click/tap rows or press ESC to return", hintBox);
 }
 
-void OptionsScene::handlePointerEvent(const SDL_Event& e) {
-  const bool pointerDown = isPointerDownEvent(e);
-  const bool pointerUp = isPointerUpEvent(e);
-  if (!pointerDown && !pointerUp) return;
+void OptionsScene::handlePointer(const input::PointerEvent& p) {
+  if (!m_game || p.action == input::PointerAction::Move) return;
 
   int rw = 0, rh = 0;
   m_game->getRenderSize(rw, rh);
-  float px = 0.0f, py = 0.0f;
-  if (!extractPointerPosition(e, rw, rh, px, py)) return;
-
-  if (pointerDown) {
-    PointerAction action = hitTestAction(px, py, rw, rh);
-    if (action != PointerAction::None) {
-      m_pointerDown = true;
-      m_pointerAction = action;
-    } else {
-      m_pointerDown = false;
-      m_pointerAction = PointerAction::None;
-    }
+  const PointerAction action = hitTestAction(p.x, p.y, rw, rh);
+
+  if (p.action == input::PointerAction::Down) {
+    m_pointerDown = action != PointerAction::None;
+    m_pointerAction = action;
+    return;
   }
 
-  if (pointerUp) {
-    PointerAction action = hitTestAction(px, py, rw, rh);
-    if (m_pointerDown && action == m_pointerAction) {
-      executeAction(action);
-    }
-    m_pointerDown = false;
-    m_pointerAction = PointerAction::None;
+  if (m_pointerDown && action == m_pointerAction) {
+    executeAction(action);
   }
+  m_pointerDown = false;
+  m_pointerAction = PointerAction::None;
 }
 
 OptionsScene::PointerAction OptionsScene::hitTestAction(float px, float py, int screenW, int screenH) const {
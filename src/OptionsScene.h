@@ -9,8 +9,10 @@ public:
   explicit OptionsScene(Game* game);
 
   void handleEvent(const SDL_Event& e) override;
+  void handlePointer(const input::PointerEvent& p) override;
   void update(float dt) override;
   void render(SDL_Renderer* r) override;
+  bool needsRedraw() const override { return false; } // changes only on input
 
 private:
   Game* m_game = nullptr; // not owned
@@ -40,7 +42,6 @@ private:
 
   void cycleResolution(int delta = 1);
   void applyResolutionAtIndex();
-  void handlePointerEvent(const SDL_Event& e);
   PointerAction hitTestAction(float px, float py, int screenW, int screenH) const;
   void executeAction(PointerAction action);
 };
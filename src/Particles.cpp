@@ -0,0 +1,187 @@
+// src/Particles.cpp
+#include "Particles.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "CpuCompositor.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define PARTICLES_SSE2 1
+#endif
+
+static int roundUp4(int n) { return (n + 3) & ~3; }
+
+ParticleSystem::ParticleSystem(int capacity) {
+  m_capacity = std::max(4, capacity);
+  const size_t lanes = (size_t)roundUp4(m_capacity);
+
+  m_x.assign(lanes, 0.0f);
+  m_y.assign(lanes, 0.0f);
+  m_vx.assign(lanes, 0.0f);
+  m_vy.assign(lanes, 0.0f);
+  m_life.assign(lanes, 0.0f);
+  m_invMaxLife.assign(lanes, 0.0f);
+  m_size.assign(lanes, 0.0f);
+  m_gravityScale.assign(lanes, 0.0f);
+  m_color.assign(lanes, SDL_Color{ 0, 0, 0, 0 });
+
+  m_verts.resize((size_t)m_capacity * 4);
+  m_indices.resize((size_t)m_capacity * 6);
+  for (int i = 0; i < m_capacity; ++i) {
+    const int v = i * 4;
+    int* idx = &m_indices[(size_t)i * 6];
+    idx[0] = v;     idx[1] = v + 1; idx[2] = v + 2;
+    idx[3] = v + 2; idx[4] = v + 3; idx[5] = v;
+  }
+}
+
+// xorshift32: cheap, allocation-free and independent of std::rand()
+float ParticleSystem::rand01() {
+  m_rng ^= m_rng << 13;
+  m_rng ^= m_rng >> 17;
+  m_rng ^= m_rng << 5;
+  return (float)(m_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::emit(const ParticleBurst& b) {
+  const int n = std::min(b.count, m_capacity - m_count);
+  for (int k = 0; k < n; ++k) {
+    const int i = m_count++;
+    const float a = b.angleMin + (b.angleMax - b.angleMin) * rand01();
+    const float s = b.speedMin + (b.speedMax - b.speedMin) * rand01();
+    const float life = b.lifeMin + (b.lifeMax - b.lifeMin) * rand01();
+
+    m_x[i] = b.x;
+    m_y[i] = b.y;
+    m_vx[i] = std::cos(a) * s;
+    m_vy[i] = std::sin(a) * s;
+    m_life[i] = life;
+    m_invMaxLife[i] = 1.0f / std::max(0.001f, life);
+    m_size[i] = b.size * (0.6f + 0.8f * rand01());
+    m_gravityScale[i] = b.gravityScale;
+    m_color[i] = b.color;
+  }
+}
+
+void ParticleSystem::shiftX(float dx) {
+  for (int i = 0; i < m_count; ++i) m_x[i] += dx;
+}
+
+void ParticleSystem::update(float dt, float gravity, float groundY) {
+  if (m_count == 0) return;
+  integrate(dt, gravity, groundY);
+  compact();
+}
+
+void ParticleSystem::integrate(float dt, float gravity, float groundY) {
+  const int n = roundUp4(m_count); // padding lanes are harmless
+
+#ifdef PARTICLES_SSE2
+  const __m128 vdt = _mm_set1_ps(dt);
+  const __m128 vgdt = _mm_set1_ps(gravity * dt);
+  const __m128 vground = _mm_set1_ps(groundY);
+  const __m128 vbounce = _mm_set1_ps(-0.3f);
+  const __m128 vfriction = _mm_set1_ps(0.6f);
+
+  for (int i = 0; i < n; i += 4) {
+    __m128 x = _mm_loadu_ps(&m_x[i]);
+    __m128 y = _mm_loadu_ps(&m_y[i]);
+    __m128 vx = _mm_loadu_ps(&m_vx[i]);
+    __m128 vy = _mm_loadu_ps(&m_vy[i]);
+    __m128 life = _mm_loadu_ps(&m_life[i]);
+    const __m128 gs = _mm_loadu_ps(&m_gravityScale[i]);
+
+    vy = _mm_add_ps(vy, _mm_mul_ps(vgdt, gs));
+    x = _mm_add_ps(x, _mm_mul_ps(vx, vdt));
+    y = _mm_add_ps(y, _mm_mul_ps(vy, vdt));
+    life = _mm_sub_ps(life, vdt);
+
+    // below ground: clamp, damp and reflect
+    const __m128 hit = _mm_cmpgt_ps(y, vground);
+    y = _mm_or_ps(_mm_and_ps(hit, vground), _mm_andnot_ps(hit, y));
+    vy = _mm_or_ps(_mm_and_ps(hit, _mm_mul_ps(vy, vbounce)), _mm_andnot_ps(hit, vy));
+    vx = _mm_or_ps(_mm_and_ps(hit, _mm_mul_ps(vx, vfriction)), _mm_andnot_ps(hit, vx));
+
+    _mm_storeu_ps(&m_x[i], x);
+    _mm_storeu_ps(&m_y[i], y);
+    _mm_storeu_ps(&m_vx[i], vx);
+    _mm_storeu_ps(&m_vy[i], vy);
+    _mm_storeu_ps(&m_life[i], life);
+  }
+#else
+  // Branch-free scalar loop; compilers auto-vectorize this shape.
+  for (int i = 0; i < n; ++i) {
+    float vy = m_vy[i] + gravity * m_gravityScale[i] * dt;
+    float vx = m_vx[i];
+    float y = m_y[i] + vy * dt;
+    const bool hit = y > groundY;
+
+    m_x[i] += vx * dt;
+    m_y[i] = hit ? groundY : y;
+    m_vy[i] = hit ? vy * -0.3f : vy;
+    m_vx[i] = hit ? vx * 0.6f : vx;
+    m_life[i] -= dt;
+  }
+#endif
+}
+
+// Swap-remove dead particles so live ones stay packed at the front.
+void ParticleSystem::compact() {
+  int i = 0;
+  while (i < m_count) {
+    if (m_life[i] > 0.0f) { ++i; continue; }
+
+    const int last = --m_count;
+    m_x[i] = m_x[last];
+    m_y[i] = m_y[last];
+    m_vx[i] = m_vx[last];
+    m_vy[i] = m_vy[last];
+    m_life[i] = m_life[last];
+    m_invMaxLife[i] = m_invMaxLife[last];
+    m_size[i] = m_size[last];
+    m_gravityScale[i] = m_gravityScale[last];
+    m_color[i] = m_color[last];
+  }
+}
+
+void ParticleSystem::render(SDL_Renderer* r, float camX, float zoom,
+                            float worldGroundY, float screenGroundY) {
+  if (!r || m_count == 0) return;
+
+  for (int i = 0; i < m_count; ++i) {
+    const float sx = (m_x[i] - camX) * zoom;
+    const float sy = screenGroundY + (m_y[i] - worldGroundY) * zoom;
+    const float h = m_size[i] * zoom * 0.5f;
+
+    SDL_Color c = m_color[i];
+    const float fade = std::clamp(m_life[i] * m_invMaxLife[i], 0.0f, 1.0f);
+    c.a = (Uint8)(c.a * fade);
+
+    SDL_Vertex* v = &m_verts[(size_t)i * 4];
+    v[0] = SDL_Vertex{ { sx - h, sy - h }, c, { 0.0f, 0.0f } };
+    v[1] = SDL_Vertex{ { sx + h, sy - h }, c, { 0.0f, 0.0f } };
+    v[2] = SDL_Vertex{ { sx + h, sy + h }, c, { 0.0f, 0.0f } };
+    v[3] = SDL_Vertex{ { sx - h, sy + h }, c, { 0.0f, 0.0f } };
+  }
+
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+  SDL_RenderGeometry(r, nullptr, m_verts.data(), m_count * 4, m_indices.data(), m_count * 6);
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+}
+
+void ParticleSystem::renderCpu(cpu::Canvas& canvas, float camX, float zoom,
+                               float worldGroundY, float screenGroundY) const {
+  for (int i = 0; i < m_count; ++i) {
+    const float sx = (m_x[i] - camX) * zoom;
+    const float sy = screenGroundY + (m_y[i] - worldGroundY) * zoom;
+    const float h = m_size[i] * zoom * 0.5f;
+
+    SDL_Color c = m_color[i];
+    const float fade = std::clamp(m_life[i] * m_invMaxLife[i], 0.0f, 1.0f);
+    c.a = (Uint8)(c.a * fade);
+
+    canvas.fill(SDL_FRect{ sx - h, sy - h, h * 2.0f, h * 2.0f }, c);
+  }
+}
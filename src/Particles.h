@@ -0,0 +1,76 @@
+// src/Particles.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+namespace cpu { class Canvas; }
+
+// Describes one emission burst in world units.
+struct ParticleBurst {
+  float x = 0.0f;
+  float y = 0.0f;
+  int count = 16;
+
+  // launch direction is picked in [angleMin, angleMax] (radians, 0 = +x,
+  // -pi/2 = straight up), speed in [speedMin, speedMax]
+  float angleMin = -3.14159f;
+  float angleMax = 0.0f;
+  float speedMin = 60.0f;
+  float speedMax = 220.0f;
+
+  float lifeMin = 0.25f;
+  float lifeMax = 0.6f;
+  float size = 6.0f;
+  float gravityScale = 0.5f;
+  SDL_Color color { 200, 190, 170, 220 };
+};
+
+// Fixed-capacity particle pool stored as structure-of-arrays so the
+// integrator can process 4 particles per instruction. All memory is
+// allocated once in the constructor; bursts that overflow are dropped.
+class ParticleSystem {
+public:
+  explicit ParticleSystem(int capacity = 32768);
+
+  void emit(const ParticleBurst& burst);
+  void clear() { m_count = 0; }
+
+  // Moves every live particle by dx (floating-origin rebase).
+  void shiftX(float dx);
+
+  // Integrates velocity/position/lifetime, bounces on groundY, then drops
+  // expired particles.
+  void update(float dt, float gravity, float groundY);
+
+  // Draws every live particle as a quad in one SDL_RenderGeometry call.
+  // World -> screen is the ground-anchored zoom::Camera mapping.
+  void render(SDL_Renderer* r, float camX, float zoom,
+              float worldGroundY, float screenGroundY);
+
+  // Same mapping, recorded as blended fills on the CPU compositor.
+  void renderCpu(cpu::Canvas& canvas, float camX, float zoom,
+                 float worldGroundY, float screenGroundY) const;
+
+  int count() const { return m_count; }
+  int capacity() const { return m_capacity; }
+
+private:
+  float rand01();
+  void integrate(float dt, float gravity, float groundY);
+  void compact();
+
+  int m_capacity = 0;
+  int m_count = 0;
+  unsigned m_rng = 0x9E3779B9u;
+
+  // SoA lanes (padded to a multiple of 4)
+  std::vector<float> m_x, m_y, m_vx, m_vy;
+  std::vector<float> m_life, m_invMaxLife;
+  std::vector<float> m_size, m_gravityScale;
+  std::vector<SDL_Color> m_color;
+
+  // Render scratch (4 vertices + 6 indices per particle, indices prebuilt)
+  std::vector<SDL_Vertex> m_verts;
+  std::vector<int> m_indices;
+};
@@ -0,0 +1,229 @@
+// src/Physics.cpp
+#include "Physics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace physics {
+
+// Entry times this far below 0 still count as "touching now" (float slop
+// after resolving onto a surface last frame).
+static constexpr float kEntrySlop = 1e-3f;
+
+bool overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+  return !(a.x + a.w <= b.x || b.x + b.w <= a.x ||
+           a.y + a.h <= b.y || b.y + b.h <= a.y);
+}
+
+SDL_FRect sweptBounds(const SDL_FRect& a, float dx, float dy) {
+  SDL_FRect out = a;
+  if (dx < 0.0f) out.x += dx;
+  if (dy < 0.0f) out.y += dy;
+  out.w += std::abs(dx);
+  out.h += std::abs(dy);
+  return out;
+}
+
+// Entry/exit time along one axis. A non-moving axis is either always or
+// never overlapping.
+static bool axisTimes(float aMin, float aLen, float bMin, float bLen, float d,
+                      float& entry, float& exit) {
+  constexpr float inf = std::numeric_limits<float>::infinity();
+
+  if (d > 0.0f) {
+    entry = (bMin - (aMin + aLen)) / d;
+    exit  = (bMin + bLen - aMin) / d;
+  } else if (d < 0.0f) {
+    entry = (bMin + bLen - aMin) / d;
+    exit  = (bMin - (aMin + aLen)) / d;
+  } else {
+    if (aMin + aLen <= bMin || bMin + bLen <= aMin) return false;
+    entry = -inf;
+    exit = inf;
+  }
+  return true;
+}
+
+SweepHit sweepAABB(const SDL_FRect& a, float dx, float dy, const SDL_FRect& b) {
+  SweepHit out;
+  if (dx == 0.0f && dy == 0.0f) return out;
+
+  float xEntry = 0.0f, xExit = 0.0f, yEntry = 0.0f, yExit = 0.0f;
+  if (!axisTimes(a.x, a.w, b.x, b.w, dx, xEntry, xExit)) return out;
+  if (!axisTimes(a.y, a.h, b.y, b.h, dy, yEntry, yExit)) return out;
+
+  const float entry = std::max(xEntry, yEntry);
+  const float exit = std::min(xExit, yExit);
+
+  if (entry > exit || entry > 1.0f || entry < -kEntrySlop) return out;
+  if (exit <= 0.0f) return out; // moving apart
+
+  out.hit = true;
+  out.t = std::max(0.0f, entry);
+
+  // Ties (exact corner hits) resolve vertically so ledges catch the feet.
+  if (xEntry > yEntry) out.nx = (dx > 0.0f) ? -1.0f : 1.0f;
+  else                 out.ny = (dy > 0.0f) ? -1.0f : 1.0f;
+
+  return out;
+}
+
+// -----------------------------
+// Player controller
+// -----------------------------
+bool isSolidForPlayer(const Obstacle& o, bool ducking) {
+  if (o.type == ObstacleType::JumpOver) return true;
+  if (o.type == ObstacleType::DuckUnder) return !ducking;
+  return true;
+}
+
+static unsigned applyInput(PlayerState& s, const PlayerInput& in, const PlayerTuning& t,
+                           const Obstacle* obstacles, size_t count) {
+  unsigned events = 0;
+
+  // horizontal
+  s.vx = 0.0f;
+  if (in.left)  s.vx -= t.moveSpeed;
+  if (in.right) s.vx += t.moveSpeed;
+
+  // duck (only grounded)
+  if (in.duck && s.onGround) {
+    if (!s.ducking) {
+      s.ducking = true;
+      const float oldH = s.box.h;
+      s.box.h = t.duckHeight;
+      s.box.y += (oldH - s.box.h); // keep feet grounded
+      events |= PlayerDucked;
+    }
+  } else if (s.ducking) {
+    // stand up only if not colliding when standing
+    SDL_FRect test = s.box;
+    test.y -= (t.standHeight - s.box.h);
+    test.h = t.standHeight;
+
+    bool blocked = false;
+    for (size_t i = 0; i < count; ++i) {
+      if (!isSolidForPlayer(obstacles[i], /*ducking=*/false)) continue;
+      if (overlaps(test, obstacles[i].rect)) { blocked = true; break; }
+    }
+
+    if (!blocked) {
+      s.ducking = false;
+      s.box = test;
+    }
+  }
+
+  // jump
+  if (in.jump && s.onGround && !s.ducking) {
+    s.vy = t.jumpVelocity;
+    s.onGround = false;
+    events |= PlayerJumped;
+  }
+  return events;
+}
+
+static void movePlayer(PlayerState& s, float dx, float dy,
+                       const Obstacle* obstacles, size_t count) {
+  static constexpr int kMaxIterations = 4;
+
+  for (int iter = 0; iter < kMaxIterations && (dx != 0.0f || dy != 0.0f); ++iter) {
+    const SDL_FRect reach = sweptBounds(s.box, dx, dy);
+
+    SweepHit first;
+    for (size_t i = 0; i < count; ++i) {
+      const Obstacle& o = obstacles[i];
+      if (!isSolidForPlayer(o, s.ducking)) continue;
+      if (!overlaps(reach, o.rect)) continue;
+
+      SweepHit h = sweepAABB(s.box, dx, dy, o.rect);
+      if (h.hit && h.t < first.t) first = h;
+    }
+
+    if (!first.hit) {
+      s.box.x += dx;
+      s.box.y += dy;
+      return;
+    }
+
+    s.box.x += dx * first.t;
+    s.box.y += dy * first.t;
+    dx *= (1.0f - first.t);
+    dy *= (1.0f - first.t);
+
+    if (first.nx != 0.0f) dx = 0.0f;
+
+    if (first.ny < 0.0f) {
+      // landed on top
+      dy = 0.0f;
+      if (s.vy > 0.0f) s.vy = 0.0f;
+      s.onGround = true;
+    } else if (first.ny > 0.0f) {
+      // bonked the underside
+      dy = 0.0f;
+      if (s.vy < 0.0f) s.vy = 0.0f;
+    }
+  }
+}
+
+// Push out of anything still overlapping (e.g. a bar turned solid).
+static void depenetrate(PlayerState& s, const Obstacle* obstacles, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const Obstacle& o = obstacles[i];
+    if (!isSolidForPlayer(o, s.ducking)) continue;
+    if (!overlaps(s.box, o.rect)) continue;
+
+    // smallest push along either axis
+    const float pushLeft  = (s.box.x + s.box.w) - o.rect.x;
+    const float pushRight = (o.rect.x + o.rect.w) - s.box.x;
+    const float pushUp    = (s.box.y + s.box.h) - o.rect.y;
+    const float pushDown  = (o.rect.y + o.rect.h) - s.box.y;
+
+    const float minX = std::min(pushLeft, pushRight);
+    const float minY = std::min(pushUp, pushDown);
+
+    if (minY <= minX) {
+      if (pushUp <= pushDown) {
+        s.box.y -= pushUp;
+        if (s.vy > 0.0f) s.vy = 0.0f;
+        s.onGround = true;
+      } else {
+        s.box.y += pushDown;
+        if (s.vy < 0.0f) s.vy = 0.0f;
+      }
+    } else {
+      s.box.x += (pushLeft <= pushRight) ? -pushLeft : pushRight;
+    }
+  }
+}
+
+unsigned stepPlayer(PlayerState& s, const PlayerInput& in, const PlayerTuning& t,
+                    const Obstacle* obstacles, size_t count, float dt) {
+  unsigned events = applyInput(s, in, t, obstacles, count);
+  const bool wasOnGround = s.onGround;
+
+  // Gravity is integrated exactly over the step, keeping the jump arc the
+  // same at any simulation rate.
+  const float dx = s.vx * dt;
+  const float dy = s.vy * dt + 0.5f * t.gravity * dt * dt;
+  s.vy += t.gravity * dt;
+
+  s.onGround = false;
+  movePlayer(s, dx, dy, obstacles, count);
+  if (s.box.x < t.minX) s.box.x = t.minX;
+
+  depenetrate(s, obstacles, count);
+
+  // world ground
+  const float floorY = t.groundY - s.box.h;
+  if (s.box.y >= floorY) {
+    s.box.y = floorY;
+    s.vy = 0.0f;
+    s.onGround = true;
+  }
+
+  if (s.onGround && !wasOnGround) events |= PlayerLanded;
+  return events;
+}
+
+} // namespace physics
@@ -0,0 +1,81 @@
+// src/Physics.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+#include "Level.h"
+
+namespace physics {
+
+// Result of sweeping a moving box against a static one.
+// t is the fraction of the displacement travelled before contact (0..1),
+// (nx, ny) the contact normal on the static box (e.g. ny = -1: landed on top).
+struct SweepHit {
+  bool  hit = false;
+  float t = 1.0f;
+  float nx = 0.0f;
+  float ny = 0.0f;
+};
+
+// Swept AABB (time of impact) of `a` moving by (dx, dy) against `b`.
+// Boxes that already overlap at t=0 report no hit; callers depenetrate
+// those separately.
+SweepHit sweepAABB(const SDL_FRect& a, float dx, float dy, const SDL_FRect& b);
+
+// Bounding box of `a` over the whole move (cheap broad-phase reject).
+SDL_FRect sweptBounds(const SDL_FRect& a, float dx, float dy);
+
+bool overlaps(const SDL_FRect& a, const SDL_FRect& b);
+
+// -----------------------------
+// Player controller
+// -----------------------------
+// One fixed step of the runner's movement rules. GameScene drives it every
+// frame and the level validator replays it over many input sequences, so
+// both always agree on what a layout allows.
+
+struct PlayerTuning {
+  float gravity = 2200.0f;
+  float moveSpeed = 420.0f;
+  float jumpVelocity = -900.0f;
+  float groundY = 460.0f;
+  float standHeight = 92.0f;
+  float duckHeight = 56.0f;
+  float minX = 30.0f;
+};
+
+struct PlayerInput {
+  bool left = false;
+  bool right = false;
+  bool duck = false;
+  bool jump = false; // one-shot
+};
+
+struct PlayerState {
+  SDL_FRect box{};
+  float vx = 0.0f;
+  float vy = 0.0f;
+  bool onGround = false;
+  bool ducking = false;
+};
+
+// Bits returned by stepPlayer (for effects/sound).
+enum PlayerEvent : unsigned {
+  PlayerJumped  = 1u << 0,
+  PlayerLanded  = 1u << 1,
+  PlayerDucked  = 1u << 2,
+};
+
+// Solid rules:
+// - JumpOver blocks always.
+// - DuckUnder blocks only when NOT ducking.
+bool isSolidForPlayer(const Obstacle& o, bool ducking);
+
+// Applies input, integrates gravity exactly over dt, sweeps against
+// `obstacles` (time of impact, so large dt can't tunnel), depenetrates and
+// lands on the world ground. Returns a mask of PlayerEvent.
+unsigned stepPlayer(PlayerState& s, const PlayerInput& in, const PlayerTuning& t,
+                    const Obstacle* obstacles, size_t count, float dt);
+
+} // namespace physics
@@ -0,0 +1,15 @@
+// src/PrefPath.cpp
+#include "PrefPath.h"
+
+#include <SDL2/SDL.h>
+
+static constexpr const char* kPrefOrg = "sdl2-game";
+static constexpr const char* kPrefApp = "bull-run";
+
+std::string prefPath(const char* file) {
+  char* base = SDL_GetPrefPath(kPrefOrg, kPrefApp);
+  if (!base) return std::string();
+  std::string path = std::string(base) + file;
+  SDL_free(base);
+  return path;
+}
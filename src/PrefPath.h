@@ -0,0 +1,8 @@
+// src/PrefPath.h
+#pragma once
+
+#include <string>
+
+// <SDL pref dir>/file for everything the game writes per user (renderer.cfg,
+// ghosts, telemetry, hitch reports). Empty if SDL has no pref dir.
+std::string prefPath(const char* file);
@@ -0,0 +1,285 @@
+// src/RendererProbe.cpp
+#include "RendererProbe.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Log.h"
+#include "PrefPath.h"
+#include "Trace.h"
+
+namespace renderprobe {
+
+namespace {
+
+constexpr const char* kCacheFile = "renderer.cfg";
+
+constexpr int kTargetW = 960;
+constexpr int kTargetH = 540;
+constexpr int kWarmupFrames = 3;
+constexpr int kTimedFrames = 20;
+
+int gChosen = -1;
+
+std::string driverName(int index) {
+  SDL_RendererInfo info;
+  if (SDL_GetRenderDriverInfo(index, &info) != 0 || !info.name) return std::string();
+  return info.name;
+}
+
+// "opengl,opengles2,software": cache key for this machine's driver set.
+std::string driverList() {
+  std::string out;
+  const int n = SDL_GetNumRenderDrivers();
+  for (int i = 0; i < n; ++i) {
+    if (i) out += ',';
+    out += driverName(i);
+  }
+  return out;
+}
+
+int indexOfDriver(const std::string& name) {
+  const int n = SDL_GetNumRenderDrivers();
+  for (int i = 0; i < n; ++i) {
+    if (driverName(i) == name) return i;
+  }
+  return -1;
+}
+
+// renderer.cfg: the driver list it was measured on, the winner, and any
+// driver that was being benchmarked when a previous launch died (a crashing
+// GL driver must not take every launch down with it).
+struct Cache {
+  std::string drivers;
+  std::string choice;
+  std::vector<std::string> crashed;
+};
+
+Cache loadCache(const std::string& path) {
+  Cache c;
+  std::FILE* f = path.empty() ? nullptr : std::fopen(path.c_str(), "r");
+  if (!f) return c;
+
+  char line[512];
+  while (std::fgets(line, sizeof(line), f)) {
+    line[std::strcspn(line, "\r\n")] = '\0';
+    if (std::strncmp(line, "drivers=", 8) == 0) c.drivers = line + 8;
+    else if (std::strncmp(line, "choice=", 7) == 0) c.choice = line + 7;
+    else if (std::strncmp(line, "crashed=", 8) == 0) c.crashed.push_back(line + 8);
+    else if (std::strncmp(line, "probing=", 8) == 0) c.crashed.push_back(line + 8);
+  }
+  std::fclose(f);
+  return c;
+}
+
+void saveCache(const std::string& path, const Cache& c, const char* probing) {
+  std::FILE* f = path.empty() ? nullptr : std::fopen(path.c_str(), "w");
+  if (!f) {
+    LOG_ERROR("Renderer probe: cannot write %s", path.c_str());
+    return;
+  }
+  std::fprintf(f, "drivers=%s\n", c.drivers.c_str());
+  if (!c.choice.empty()) std::fprintf(f, "choice=%s\n", c.choice.c_str());
+  for (const std::string& name : c.crashed) std::fprintf(f, "crashed=%s\n", name.c_str());
+  if (probing) std::fprintf(f, "probing=%s\n", probing);
+  std::fclose(f);
+}
+
+// 64x64 soft-edged disc: exercises alpha blending like the sprite sheets.
+SDL_Texture* makeSpriteTexture(SDL_Renderer* r) {
+  SDL_Surface* s = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (!s) return nullptr;
+
+  SDL_LockSurface(s);
+  for (int y = 0; y < 64; ++y) {
+    Uint32* row = (Uint32*)((Uint8*)s->pixels + (size_t)y * s->pitch);
+    for (int x = 0; x < 64; ++x) {
+      const int dx = x - 32, dy = y - 32;
+      const int d2 = dx * dx + dy * dy;
+      const Uint32 a = d2 >= 1024 ? 0u : (Uint32)(255 - d2 * 255 / 1024);
+      row[x] = (a << 24) | 0x00D08040u;
+    }
+  }
+  SDL_UnlockSurface(s);
+
+  SDL_Texture* t = SDL_CreateTextureFromSurface(r, s);
+  SDL_FreeSurface(s);
+  if (t) SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+  return t;
+}
+
+// One game-like frame into the current target.
+void drawWorkload(SDL_Renderer* r, SDL_Texture* sprite, SDL_Texture* text, int frame) {
+  SDL_SetRenderDrawColor(r, 20, 20, 28, 255);
+  SDL_RenderClear(r);
+
+  // ground, obstacles, HUD bars
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+  for (int i = 0; i < 120; ++i) {
+    SDL_SetRenderDrawColor(r, (Uint8)(40 + i), 90, 60, 255);
+    SDL_FRect rc { (float)((i * 37 + frame * 5) % kTargetW), (float)(300 + (i * 13) % 200), 58.0f, 48.0f };
+    SDL_RenderFillRectF(r, &rc);
+  }
+
+  // sprites (bulls, player, particles)
+  for (int i = 0; i < 400; ++i) {
+    SDL_FRect dst { (float)((i * 53 + frame * 7) % kTargetW), (float)((i * 29) % kTargetH), 48.0f, 48.0f };
+    SDL_RenderCopyExF(r, sprite, nullptr, &dst, 0.0, nullptr, (i & 1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+  }
+
+  // HUD text
+  if (text) {
+    int tw = 0, th = 0;
+    SDL_QueryTexture(text, nullptr, nullptr, &tw, &th);
+    for (int i = 0; i < 8; ++i) {
+      SDL_Rect dst { 20, 20 + i * (th + 4), tw, th };
+      SDL_RenderCopy(r, text, nullptr, &dst);
+    }
+  }
+}
+
+// Average ms per frame for driver `index`, or a negative value if the
+// driver can't run the workload.
+double benchmarkDriver(SDL_Window* window, TTF_Font* font, int index) {
+  SDL_Renderer* r = SDL_CreateRenderer(window, index, SDL_RENDERER_TARGETTEXTURE);
+  if (!r) return -1.0;
+
+  double ms = -1.0;
+  SDL_Texture* target = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, kTargetW, kTargetH);
+  SDL_Texture* sprite = makeSpriteTexture(r);
+  SDL_Texture* text = nullptr;
+  if (font) {
+    SDL_Surface* ts = TTF_RenderUTF8_Blended(font, "Level 10 / 10", SDL_Color{ 255, 255, 255, 255 });
+    if (ts) {
+      text = SDL_CreateTextureFromSurface(r, ts);
+      SDL_FreeSurface(ts);
+    }
+  }
+
+  if (target && sprite && SDL_SetRenderTarget(r, target) == 0) {
+    Uint32 pixel = 0;
+    const SDL_Rect one { 0, 0, 1, 1 };
+    Uint64 start = 0;
+
+    for (int f = 0; f < kWarmupFrames + kTimedFrames; ++f) {
+      if (f == kWarmupFrames) {
+        SDL_RenderReadPixels(r, &one, SDL_PIXELFORMAT_ARGB8888, &pixel, 4); // drain queued work
+        start = SDL_GetPerformanceCounter();
+      }
+      drawWorkload(r, sprite, text, f);
+      SDL_RenderFlush(r);
+    }
+    // reading back waits for the GPU, so the timing covers the real work
+    SDL_RenderReadPixels(r, &one, SDL_PIXELFORMAT_ARGB8888, &pixel, 4);
+    ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 /
+         (double)SDL_GetPerformanceFrequency() / kTimedFrames;
+    SDL_SetRenderTarget(r, nullptr);
+  }
+
+  if (text) SDL_DestroyTexture(text);
+  if (sprite) SDL_DestroyTexture(sprite);
+  if (target) SDL_DestroyTexture(target);
+  SDL_DestroyRenderer(r);
+  return ms;
+}
+
+} // namespace
+
+int chooseDriver(SDL_Window* window, const char* fontPath, int fontSize) {
+  TRACE_SCOPE("renderprobe::chooseDriver");
+  gChosen = -1;
+
+#ifdef __EMSCRIPTEN__
+  // one WebGL-backed driver; nothing to choose
+  (void)window;
+  (void)fontPath;
+  (void)fontSize;
+  return gChosen;
+#else
+  if (const char* forced = std::getenv("GAME_RENDER_DRIVER")) {
+    gChosen = indexOfDriver(forced);
+    LOG_INFO("Renderer: %s (forced by GAME_RENDER_DRIVER)%s", forced, gChosen < 0 ? " not found" : "");
+    return gChosen;
+  }
+
+  const int n = SDL_GetNumRenderDrivers();
+  if (!window || n <= 1) return gChosen;
+
+  const std::string path = prefPath(kCacheFile);
+  Cache cache = loadCache(path);
+  const std::string drivers = driverList();
+  if (cache.drivers != drivers) cache = Cache{}; // new driver set: measure again
+  cache.drivers = drivers;
+
+  if (!cache.choice.empty()) {
+    gChosen = indexOfDriver(cache.choice);
+    if (gChosen >= 0) {
+      LOG_INFO("Renderer: %s (cached)", cache.choice.c_str());
+      return gChosen;
+    }
+  }
+
+  // Cache miss: the game loads its font later, on a job, so open one just
+  // for the probe's text pass.
+  TTF_Font* font = fontPath ? TTF_OpenFont(fontPath, fontSize) : nullptr;
+  if (fontPath && !font) LOG_WARN("Renderer probe: no font (%s), skipping text", TTF_GetError());
+
+  double best = -1.0;
+  for (int i = 0; i < n; ++i) {
+    const std::string name = driverName(i);
+    bool crashed = false;
+    for (const std::string& c : cache.crashed) crashed = crashed || (c == name);
+    if (crashed) {
+      LOG_INFO("Renderer probe: %-12s skipped (crashed during an earlier probe)", name.c_str());
+      continue;
+    }
+
+    saveCache(path, cache, name.c_str()); // breadcrumb in case this driver crashes
+    const double ms = benchmarkDriver(window, font, i);
+    if (ms < 0.0) {
+      LOG_INFO("Renderer probe: %-12s unavailable (%s)", name.c_str(), SDL_GetError());
+      continue;
+    }
+    LOG_INFO("Renderer probe: %-12s %.3f ms/frame", name.c_str(), ms);
+    if (best < 0.0 || ms < best) {
+      best = ms;
+      gChosen = i;
+    }
+  }
+
+  if (font) TTF_CloseFont(font);
+
+  if (gChosen >= 0) {
+    cache.choice = driverName(gChosen);
+    LOG_INFO("Renderer: %s (probed)", cache.choice.c_str());
+  }
+  saveCache(path, cache, nullptr);
+  return gChosen;
+#endif
+}
+
+int chosenDriver() { return gChosen; }
+
+SDL_Renderer* createRenderer(SDL_Window* window) {
+  // software doesn't advertise ACCELERATED; ask only for what it has
+  Uint32 flags = SDL_RENDERER_PRESENTVSYNC;
+  SDL_RendererInfo info;
+  if (gChosen >= 0 && SDL_GetRenderDriverInfo(gChosen, &info) == 0) {
+    flags |= (info.flags & SDL_RENDERER_ACCELERATED);
+  } else {
+    flags |= SDL_RENDERER_ACCELERATED;
+  }
+
+  SDL_Renderer* r = SDL_CreateRenderer(window, gChosen, flags);
+  if (!r && gChosen >= 0) {
+    LOG_ERROR("SDL_CreateRenderer(%s) failed: %s; using default driver",
+              driverName(gChosen).c_str(), SDL_GetError());
+    r = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  }
+  return r;
+}
+
+} // namespace renderprobe
@@ -0,0 +1,32 @@
+// src/RendererProbe.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+// Picks the render driver to use on this machine.
+//
+// On first launch every driver SDL reports is benchmarked with a short
+// offscreen workload shaped like a game frame (fills, alpha sprites, text)
+// and the fastest is stored in <pref path>/renderer.cfg together with the
+// driver list it was measured against. Later launches reuse it until the
+// driver list changes. GAME_RENDER_DRIVER=<name> forces a driver.
+//
+// Some machines are faster on the software renderer than on a broken GL
+// driver, which is why this is measured instead of assumed.
+namespace renderprobe {
+
+// Runs (or loads) the probe. The font at `fontPath` is opened only when the
+// probe actually runs (TTF_Init first) and closed again; without it the
+// text part is skipped. Returns the chosen driver index, -1 for SDL's
+// default.
+int chooseDriver(SDL_Window* window, const char* fontPath, int fontSize);
+
+// Driver picked by chooseDriver (-1 before it ran, or on the web).
+int chosenDriver();
+
+// SDL_CreateRenderer with the chosen driver, falling back to SDL's
+// default driver if that fails.
+SDL_Renderer* createRenderer(SDL_Window* window);
+
+} // namespace renderprobe
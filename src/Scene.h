@@ -2,6 +2,8 @@
 #pragma once
 #include <SDL2/SDL.h>
 
+#include "Input.h"
+
 class Scene {
 public:
   virtual ~Scene() = default;
@@ -9,14 +11,28 @@ public:
   // Event-based input (no polling here unless you want it)
   virtual void handleEvent(const SDL_Event& e) = 0;
 
+  // Mouse/touch, normalized by Game's input::Router (render-output pixels,
+  // motion coalesced to one sample per frame). Raw pointer events never
+  // reach handleEvent.
+  virtual void handlePointer(const input::PointerEvent&) {}
+  virtual void handleGesture(const input::GestureEvent&) {}
+
   // Per-frame update
   virtual void update(float dt) = 0;
 
   // Draw scene content. Game() will call SDL_RenderPresent().
   virtual void render(SDL_Renderer* r) = 0;
 
+  // False when the scene is static and the last presented frame is still
+  // correct. Game then stops updating/rendering and sleeps until the next
+  // event, which always gets one fresh frame.
+  virtual bool needsRedraw() const { return true; }
+
   // IMPORTANT:
   // Called when Game recreates the SDL_Renderer (fullscreen / resize).
   // Default is no-op so scenes without textures don't care.
   virtual void onRendererChanged(SDL_Renderer*) {}
+
+  // Live obstacle count for hitch reports (see Hitch.h); 0 outside gameplay.
+  virtual size_t obstacleCount() const { return 0; }
 };
@@ -0,0 +1,74 @@
+// src/Snapshot.h
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Ecs.h"
+#include "Physics.h"
+
+// Plain-data copy of everything GameScene::update advances: player, bull
+// herd, camera and gameplay timers. Obstacles don't change during a run, so
+// they are referenced by layout id instead of copied. Capturing/restoring is
+// a few hundred bytes of copying, cheap enough to do every frame.
+constexpr int kMaxSnapshotChasers = 8;
+
+struct ChaserSnapshot {
+  ecs::Entity entity = ecs::kNullEntity;
+  SDL_FRect rect{};
+  float vx = 0.0f;
+  float vy = 0.0f;
+  float animT = 0.0f;
+  bool onGround = false;
+};
+
+struct SimSnapshot {
+  uint32_t layoutId = 0;          // obstacles these positions belong to
+  int64_t originChunk = 0;        // floating origin the positions are relative to
+  physics::PlayerState player;
+  float camX = 0.0f;
+  float playerAnimT = 0.0f;
+  float bullDustT = 0.0f;
+  float runTime = 0.0f;           // seconds since the level (re)started
+  int chaserCount = 0;
+  ChaserSnapshot chasers[kMaxSnapshotChasers];
+};
+
+static_assert(std::is_trivially_copyable<SimSnapshot>::value, "SimSnapshot must stay POD");
+
+// Fixed-capacity history of snapshots, newest last. Pushing into a full
+// ring overwrites the oldest entry; all storage is allocated up front.
+class SnapshotRing {
+public:
+  explicit SnapshotRing(int capacity) : m_items((size_t)(capacity > 0 ? capacity : 1)) {}
+
+  void clear() { m_head = 0; m_count = 0; }
+  int size() const { return m_count; }
+  int capacity() const { return (int)m_items.size(); }
+  bool empty() const { return m_count == 0; }
+
+  // Slot for the next snapshot (fill it in place, no extra copy).
+  SimSnapshot& push() {
+    SimSnapshot& slot = m_items[(size_t)m_head];
+    m_head = (m_head + 1) % capacity();
+    if (m_count < capacity()) ++m_count;
+    return slot;
+  }
+
+  // Newest snapshot; the ring must not be empty.
+  const SimSnapshot& back() const {
+    return m_items[(size_t)((m_head + capacity() - 1) % capacity())];
+  }
+
+  void popBack() {
+    if (m_count == 0) return;
+    m_head = (m_head + capacity() - 1) % capacity();
+    --m_count;
+  }
+
+private:
+  std::vector<SimSnapshot> m_items;
+  int m_head = 0;   // next slot to write
+  int m_count = 0;
+};
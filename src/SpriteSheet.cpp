@@ -0,0 +1,217 @@
+// src/SpriteSheet.cpp
+#include "SpriteSheet.h"
+
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "Log.h"
+#include "TextureRegistry.h"
+
+// Transparent gap kept around packed cells so linear filtering doesn't
+// bleed neighbours into each other. The budget may halve the atlas up to
+// textures::kMaxHalvings times, so cells sit on a grid of that scale and
+// the gap is scaled by it: kPadding pixels survive every halving.
+static constexpr int kPadding = 2;
+static constexpr int kAlign = 1 << textures::kMaxHalvings;
+static constexpr int kGap = kPadding * kAlign;
+
+static int alignUp(int v) { return (v + kAlign - 1) & ~(kAlign - 1); }
+
+// Tight bounding box of pixels with alpha > 0 inside `cell` (w/h = 0 if
+// the cell is fully transparent). Surface must be ARGB8888 and locked.
+static SDL_Rect alphaBounds(const SDL_Surface* s, const SDL_Rect& cell) {
+  int minX = cell.x + cell.w, minY = cell.y + cell.h, maxX = -1, maxY = -1;
+
+  for (int y = cell.y; y < cell.y + cell.h; ++y) {
+    const Uint32* row = (const Uint32*)((const Uint8*)s->pixels + (size_t)y * s->pitch);
+    for (int x = cell.x; x < cell.x + cell.w; ++x) {
+      if ((row[x] >> 24) == 0) continue;
+      minX = std::min(minX, x);
+      maxX = std::max(maxX, x);
+      minY = std::min(minY, y);
+      maxY = std::max(maxY, y);
+    }
+  }
+
+  if (maxX < 0) return SDL_Rect{ cell.x, cell.y, 0, 0 };
+  return SDL_Rect{ minX, minY, maxX - minX + 1, maxY - minY + 1 };
+}
+
+SDL_FRect SpriteSheet::place(int i, const SDL_FRect& cellDest, bool flipX) const {
+  const SpriteFrame& f = frames[(size_t)i];
+  const float offX = flipX ? (1.0f - f.offX - f.sizeW) : f.offX;
+  return SDL_FRect{
+    cellDest.x + offX * cellDest.w,
+    cellDest.y + f.offY * cellDest.h,
+    f.sizeW * cellDest.w,
+    f.sizeH * cellDest.h
+  };
+}
+
+void SpriteSheet::draw(SDL_Renderer* r, int i, const SDL_FRect& cellDest, bool flipX) const {
+  if (!texture || i < 0 || i >= frameCount()) return;
+  const SpriteFrame& f = frames[(size_t)i];
+  if (f.empty()) return;
+
+  const SDL_FRect dest = place(i, cellDest, flipX);
+  SDL_RenderCopyExF(r, texture, &f.src, &dest, 0.0, nullptr,
+                    flipX ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+}
+
+bool decodeTrimmedSheet(const char* path, int cols, int rows, DecodedSheet& out) {
+  freeDecodedSheet(out);
+  if (!path || cols <= 0 || rows <= 0) return false;
+
+  SDL_Surface* raw = IMG_Load(path);
+  if (!raw) {
+    LOG_ERROR("IMG_Load failed (%s): %s", path, IMG_GetError());
+    return false;
+  }
+  SDL_Surface* img = SDL_ConvertSurfaceFormat(raw, SDL_PIXELFORMAT_ARGB8888, 0);
+  SDL_FreeSurface(raw);
+  if (!img) {
+    LOG_ERROR("SDL_ConvertSurfaceFormat failed (%s): %s", path, SDL_GetError());
+    return false;
+  }
+
+  const int cellW = img->w / cols;
+  const int cellH = img->h / rows;
+  const int count = cols * rows;
+
+  SDL_LockSurface(img);
+
+  // 1) tight bounds per cell
+  std::vector<SDL_Rect> bounds((size_t)count);
+  long long area = 0;
+  int widest = 1;
+  for (int i = 0; i < count; ++i) {
+    const SDL_Rect cell { (i % cols) * cellW, (i / cols) * cellH, cellW, cellH };
+    bounds[(size_t)i] = alphaBounds(img, cell);
+    area += (long long)alignUp(bounds[(size_t)i].w + kGap) * alignUp(bounds[(size_t)i].h + kGap);
+    widest = std::max(widest, alignUp(bounds[(size_t)i].w) + 2 * kGap);
+  }
+
+  // 2) shelf-pack, tallest first
+  std::vector<int> order((size_t)count);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int a, int b) { return bounds[(size_t)a].h > bounds[(size_t)b].h; });
+
+  const int atlasW = std::max(widest, (int)std::ceil(std::sqrt((double)area * 1.15)));
+  std::vector<SDL_Point> pos((size_t)count);
+  int penX = kGap, penY = kGap, shelfH = 0;
+
+  for (int i : order) {
+    const SDL_Rect& b = bounds[(size_t)i];
+    if (b.w == 0) continue;
+    if (penX + b.w + kGap > atlasW) {
+      penX = kGap;
+      penY = alignUp(penY + shelfH) + kGap;
+      shelfH = 0;
+    }
+    pos[(size_t)i] = SDL_Point{ penX, penY };
+    penX = alignUp(penX + b.w) + kGap;
+    shelfH = std::max(shelfH, b.h);
+  }
+  const int atlasH = std::max(1, alignUp(penY + shelfH) + kGap);
+
+  // 3) copy trimmed cells into the atlas
+  SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasW, atlasH, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (!atlas) {
+    SDL_UnlockSurface(img);
+    SDL_FreeSurface(img);
+    LOG_ERROR("SDL_CreateRGBSurfaceWithFormat failed (%s): %s", path, SDL_GetError());
+    return false;
+  }
+
+  SDL_LockSurface(atlas);
+  std::memset(atlas->pixels, 0, (size_t)atlas->pitch * atlas->h);
+  for (int i = 0; i < count; ++i) {
+    const SDL_Rect& b = bounds[(size_t)i];
+    for (int y = 0; y < b.h; ++y) {
+      const Uint8* src = (const Uint8*)img->pixels + (size_t)(b.y + y) * img->pitch + (size_t)b.x * 4;
+      Uint8* dst = (Uint8*)atlas->pixels + (size_t)(pos[(size_t)i].y + y) * atlas->pitch + (size_t)pos[(size_t)i].x * 4;
+      std::memcpy(dst, src, (size_t)b.w * 4);
+    }
+  }
+  SDL_UnlockSurface(atlas);
+  SDL_UnlockSurface(img);
+
+  out.label = path;
+  out.srcW = img->w;
+  out.srcH = img->h;
+  SDL_FreeSurface(img);
+  out.atlas = atlas;
+
+  // 4) frame metadata, in full-resolution atlas pixels
+  out.cols = cols;
+  out.rows = rows;
+  out.frames.resize((size_t)count);
+  for (int i = 0; i < count; ++i) {
+    const SDL_Rect& b = bounds[(size_t)i];
+    SpriteFrame& f = out.frames[(size_t)i];
+    const int cellX = (i % cols) * cellW;
+    const int cellY = (i / cols) * cellH;
+
+    f.src = SDL_Rect{ pos[(size_t)i].x, pos[(size_t)i].y, b.w, b.h };
+    f.offX = (float)(b.x - cellX) / (float)std::max(1, cellW);
+    f.offY = (float)(b.y - cellY) / (float)std::max(1, cellH);
+    f.sizeW = (float)b.w / (float)std::max(1, cellW);
+    f.sizeH = (float)b.h / (float)std::max(1, cellH);
+  }
+  return true;
+}
+
+bool uploadTrimmedSheet(SDL_Renderer* r, DecodedSheet& decoded, SpriteSheet& out) {
+  destroySheet(out);
+  if (!r || !decoded.atlas) return false;
+
+  const int atlasW = decoded.atlas->w, atlasH = decoded.atlas->h;
+  int halvings = 0;
+  out.texture = textures::createWithinBudget(r, decoded.atlas, decoded.label.c_str(), &halvings);
+  if (!out.texture) {
+    freeDecodedSheet(decoded);
+    return false;
+  }
+
+  // atlas rects scaled down if the budget halved it (cells are aligned to
+  // the largest halving, so only the far edges can land mid-pixel: round
+  // those out, into the gap)
+  out.cols = decoded.cols;
+  out.rows = decoded.rows;
+  out.frames = std::move(decoded.frames);
+  const int round = (1 << halvings) - 1;
+  for (SpriteFrame& f : out.frames) {
+    const int x0 = f.src.x >> halvings, y0 = f.src.y >> halvings;
+    const int x1 = (f.src.x + f.src.w + round) >> halvings, y1 = (f.src.y + f.src.h + round) >> halvings;
+    f.src = SDL_Rect{ x0, y0, x1 - x0, y1 - y0 };
+  }
+
+  LOG_INFO("Trimmed %s: %dx%d -> %dx%d atlas", decoded.label.c_str(), decoded.srcW, decoded.srcH,
+           atlasW >> halvings, atlasH >> halvings);
+  freeDecodedSheet(decoded);
+  return true;
+}
+
+bool loadTrimmedSheet(SDL_Renderer* r, const char* path, int cols, int rows, SpriteSheet& out) {
+  destroySheet(out);
+  if (!r) return false;
+
+  DecodedSheet decoded;
+  return decodeTrimmedSheet(path, cols, rows, decoded) && uploadTrimmedSheet(r, decoded, out);
+}
+
+void freeDecodedSheet(DecodedSheet& decoded) {
+  if (decoded.atlas) SDL_FreeSurface(decoded.atlas);
+  decoded.atlas = nullptr;
+  decoded.frames.clear();
+}
+
+void destroySheet(SpriteSheet& sheet) {
+  textures::destroy(sheet.texture);
+  sheet.frames.clear();
+  sheet.cols = 1;
+  sheet.rows = 1;
+}
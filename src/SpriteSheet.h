@@ -0,0 +1,65 @@
+// src/SpriteSheet.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+// One cell of a sheet after trimming its transparent margins.
+// `src` is the tight region inside the packed atlas texture; off/size
+// locate that region inside the original (untrimmed) cell, as fractions
+// of the cell size, so it can be drawn exactly where the full cell was.
+struct SpriteFrame {
+  SDL_Rect src{};
+  float offX = 0.0f;
+  float offY = 0.0f;
+  float sizeW = 0.0f;
+  float sizeH = 0.0f;
+
+  bool empty() const { return src.w <= 0 || src.h <= 0; }
+};
+
+// A cols x rows grid sheet whose cells were trimmed at load time and
+// repacked into one compact atlas texture (see loadTrimmedSheet).
+struct SpriteSheet {
+  SDL_Texture* texture = nullptr;
+  int cols = 1;
+  int rows = 1;
+  std::vector<SpriteFrame> frames; // row-major, cols * rows
+
+  bool valid() const { return texture != nullptr && !frames.empty(); }
+  int frameCount() const { return (int)frames.size(); }
+
+  // Destination of frame `i`, given where the untrimmed cell would go.
+  SDL_FRect place(int i, const SDL_FRect& cellDest, bool flipX) const;
+
+  // Draws frame `i` into `cellDest` (nothing for fully transparent cells).
+  void draw(SDL_Renderer* r, int i, const SDL_FRect& cellDest, bool flipX = false) const;
+};
+
+// Loads `path` as a cols x rows grid, trims each cell to its alpha
+// bounding box, packs the trimmed cells into an atlas and uploads it
+// through the texture registry (budget applies). Returns false on failure.
+bool loadTrimmedSheet(SDL_Renderer* r, const char* path, int cols, int rows, SpriteSheet& out);
+
+// loadTrimmedSheet in two halves, so decoding can run on a worker thread:
+// decode (PNG decode, trim, pack; touches no renderer state) then upload
+// (texture creation; must run on the thread that owns the renderer).
+struct DecodedSheet {
+  SDL_Surface* atlas = nullptr;
+  int cols = 1;
+  int rows = 1;
+  std::vector<SpriteFrame> frames; // src in full-resolution atlas pixels
+  std::string label;
+  int srcW = 0;
+  int srcH = 0;
+};
+
+bool decodeTrimmedSheet(const char* path, int cols, int rows, DecodedSheet& out);
+
+// Consumes `decoded` (its surface is freed either way).
+bool uploadTrimmedSheet(SDL_Renderer* r, DecodedSheet& decoded, SpriteSheet& out);
+
+void freeDecodedSheet(DecodedSheet& decoded);
+
+void destroySheet(SpriteSheet& sheet);
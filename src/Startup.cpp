@@ -0,0 +1,68 @@
+// src/Startup.cpp
+#include "Startup.h"
+
+#include <SDL2/SDL.h>
+#include <cstdio>
+
+#ifdef __EMSCRIPTEN__
+  #include <emscripten.h>
+#endif
+
+namespace startup {
+
+namespace {
+
+constexpr int kMaxPhases = 16;
+
+struct Phase {
+  const char* name;
+  double endMs;
+};
+
+Phase gPhases[kMaxPhases];
+int gCount = 0;
+double gBeginMs = 0.0;
+bool gReported = false;
+
+#ifndef __EMSCRIPTEN__
+Uint64 gOrigin = 0;
+#endif
+
+} // namespace
+
+double nowMs() {
+#ifdef __EMSCRIPTEN__
+  return emscripten_get_now();
+#else
+  if (gOrigin == 0) gOrigin = SDL_GetPerformanceCounter();
+  return (double)(SDL_GetPerformanceCounter() - gOrigin) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+#endif
+}
+
+void begin() {
+  gBeginMs = nowMs();
+  gCount = 0;
+  gReported = false;
+}
+
+void mark(const char* phase) {
+  if (gReported || gCount >= kMaxPhases) return;
+  gPhases[gCount++] = Phase{ phase, nowMs() };
+}
+
+void report() {
+  if (gReported) return;
+  gReported = true;
+
+  std::printf("Startup (ms):\n");
+#ifdef __EMSCRIPTEN__
+  std::printf("  %-16s %8.1f %8.1f\n", "page -> main", gBeginMs, gBeginMs);
+#endif
+  double prev = gBeginMs;
+  for (int i = 0; i < gCount; ++i) {
+    std::printf("  %-16s %8.1f %8.1f\n", gPhases[i].name, gPhases[i].endMs - prev, gPhases[i].endMs);
+    prev = gPhases[i].endMs;
+  }
+}
+
+} // namespace startup
@@ -0,0 +1,27 @@
+// src/Startup.h
+#pragma once
+
+// Startup phase timing (time to first frame / time to interactive).
+//
+//   startup::mark("SDL_Init");        // after each phase
+//   ...
+//   startup::report();                // once the game is interactive
+//
+// Times are measured from begin() on native and from page navigation on
+// the web (performance.now()), where download + compile time shows up as
+// the gap before main.
+namespace startup {
+
+// Call first thing in main().
+void begin();
+
+// Ends the current phase and names it. Marks after report() are ignored.
+void mark(const char* phase);
+
+// Milliseconds since the time origin (see above).
+double nowMs();
+
+// Prints every phase with its duration and cumulative time, once.
+void report();
+
+} // namespace startup
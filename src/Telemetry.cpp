@@ -0,0 +1,177 @@
+// src/Telemetry.cpp
+#include "Telemetry.h"
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "Log.h"
+#include "PrefPath.h"
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+  #include <chrono>
+  #include <thread>
+  #define TELEMETRY_THREADS 1
+#endif
+
+namespace telemetry {
+
+namespace {
+
+constexpr uint32_t kRingSize = 4096; // power of two; ~1 minute of heavy play
+constexpr int kFlushMs = 250;
+#ifndef TELEMETRY_THREADS
+constexpr uint32_t kFlushFrames = 64;
+#endif
+
+struct State {
+  std::FILE* file = nullptr;
+  uint64_t frameTicks = 0;
+
+  // SPSC ring: head is written by record(), tail by the writer.
+  Record ring[kRingSize];
+  std::atomic<uint32_t> head{ 0 };
+  std::atomic<uint32_t> tail{ 0 };
+
+  // Single writer each, so plain load/store suffices.
+  std::atomic<uint64_t> recorded{ 0 };
+  std::atomic<uint64_t> dropped{ 0 };
+  std::atomic<uint64_t> written{ 0 };
+
+  std::vector<Record> batch; // writer-side copy, reused
+
+#ifdef TELEMETRY_THREADS
+  std::thread writer;
+  std::atomic<bool> running{ false };
+#else
+  uint32_t framesSinceFlush = 0;
+#endif
+};
+
+State g;
+
+void bump(std::atomic<uint64_t>& a, uint64_t v) {
+  a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+std::string sessionPath() {
+  char name[64];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(name, sizeof(name), "telemetry_%Y%m%d_%H%M%S.btel", std::localtime(&now));
+  return prefPath(name);
+}
+
+// Writer side: moves everything queued into the file in one fwrite.
+void drain() {
+  const uint32_t tail = g.tail.load(std::memory_order_relaxed);
+  const uint32_t head = g.head.load(std::memory_order_acquire);
+  if (head == tail) return;
+
+  g.batch.clear();
+  for (uint32_t i = tail; i != head; ++i) g.batch.push_back(g.ring[i & (kRingSize - 1)]);
+  g.tail.store(head, std::memory_order_release);
+
+  if (std::fwrite(g.batch.data(), sizeof(Record), g.batch.size(), g.file) == g.batch.size()) {
+    bump(g.written, g.batch.size());
+  }
+  std::fflush(g.file);
+}
+
+#ifdef TELEMETRY_THREADS
+void writerMain() {
+  while (g.running.load(std::memory_order_acquire)) {
+    drain();
+    std::this_thread::sleep_for(std::chrono::milliseconds(kFlushMs));
+  }
+  drain();
+}
+#endif
+
+} // namespace
+
+bool init() {
+  if (g.file) return true;
+  const char* env = std::getenv("GAME_TELEMETRY");
+  if (!env || std::atoi(env) == 0) return false;
+
+  const std::string path = sessionPath();
+  g.file = path.empty() ? nullptr : std::fopen(path.c_str(), "wb");
+  if (!g.file) {
+    LOG_WARN("Telemetry disabled: cannot open %s", path.empty() ? "(no pref path)" : path.c_str());
+    return false;
+  }
+
+  FileHeader h{};
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.version = kVersion;
+  h.headerSize = (uint16_t)sizeof(FileHeader);
+  h.recordSize = (uint32_t)sizeof(Record);
+  h.tickFrequency = SDL_GetPerformanceFrequency();
+  h.startTicks = SDL_GetPerformanceCounter();
+  h.startUnixTime = (int64_t)std::time(nullptr);
+  std::fwrite(&h, sizeof(h), 1, g.file);
+
+  g.frameTicks = h.startTicks;
+  g.batch.reserve(kRingSize);
+
+#ifdef TELEMETRY_THREADS
+  g.running.store(true, std::memory_order_release);
+  g.writer = std::thread(writerMain);
+#endif
+  return true;
+}
+
+void shutdown() {
+  if (!g.file) return;
+
+#ifdef TELEMETRY_THREADS
+  g.running.store(false, std::memory_order_release);
+  if (g.writer.joinable()) g.writer.join();
+#else
+  drain();
+#endif
+
+  std::fclose(g.file);
+  g.file = nullptr;
+}
+
+void beginFrame() {
+  if (!g.file) return;
+  g.frameTicks = SDL_GetPerformanceCounter();
+
+#ifndef TELEMETRY_THREADS
+  if (++g.framesSinceFlush >= kFlushFrames) {
+    g.framesSinceFlush = 0;
+    drain();
+  }
+#endif
+}
+
+void record(Event type, uint16_t level, float x, uint32_t a, uint32_t b) {
+  if (!g.file) return;
+
+  const uint32_t head = g.head.load(std::memory_order_relaxed);
+  if (head - g.tail.load(std::memory_order_acquire) >= kRingSize) {
+    bump(g.dropped, 1);
+    return;
+  }
+  g.ring[head & (kRingSize - 1)] = Record{ g.frameTicks, (uint16_t)type, level, x, a, b };
+  g.head.store(head + 1, std::memory_order_release);
+  bump(g.recorded, 1);
+}
+
+Stats stats() {
+  Stats s;
+  s.recorded = g.recorded.load(std::memory_order_relaxed);
+  s.dropped = g.dropped.load(std::memory_order_relaxed);
+  s.written = g.written.load(std::memory_order_relaxed);
+  return s;
+}
+
+} // namespace telemetry
@@ -0,0 +1,76 @@
+// src/Telemetry.h
+#pragma once
+
+#include <cstdint>
+
+// Gameplay telemetry: fixed-size binary events in a lock-free ring, written
+// to <pref path>/telemetry_<date>_<time>.btel by a background thread and
+// aggregated offline by tools/TelemetryReport.cpp.
+//
+// record() only copies 24 bytes into the ring (no clock read, no locks, no
+// allocation, no I/O): events carry the timestamp taken once per frame by
+// beginFrame(). A full ring drops the event and counts it.
+//
+// record() / beginFrame() must be called from one thread (the game thread).
+// Off unless GAME_TELEMETRY=1: every session writes a new file and nothing
+// prunes them.
+namespace telemetry {
+
+enum class Event : uint16_t {
+  SceneChange,      // a = previous SceneId, b = new SceneId
+  RendererRebuild,  // a = render width, b = render height
+  LevelStart,       // a = 1 for an authored layout
+  Death,            // x = where, a = run time (ms)
+  LevelComplete,    // a = run time (ms)
+  Jump,
+  Duck,
+  Count
+};
+
+constexpr uint16_t kNoLevel = 0xFFFF;
+
+// File: FileHeader, then Record[] until EOF.
+constexpr char     kMagic[4] = { 'B', 'T', 'E', 'L' };
+constexpr uint16_t kVersion  = 1;
+
+struct FileHeader {
+  char     magic[4];
+  uint16_t version;
+  uint16_t headerSize;       // offset of the first record
+  uint32_t recordSize;
+  uint32_t reserved;
+  uint64_t tickFrequency;    // Record::ticks per second
+  uint64_t startTicks;       // ticks at init()
+  int64_t  startUnixTime;    // wall clock at init()
+};
+
+struct Record {
+  uint64_t ticks;            // frame timestamp (performance counter)
+  uint16_t type;             // Event
+  uint16_t level;            // 0-based, kNoLevel outside gameplay
+  float    x;                // level-space player x, 0 if not applicable
+  uint32_t a;                // payload, see Event
+  uint32_t b;
+};
+
+static_assert(sizeof(FileHeader) == 40, "telemetry header layout changed");
+static_assert(sizeof(Record) == 24, "telemetry record layout changed");
+
+bool init();
+void shutdown(); // drains the ring and closes the file
+
+// Stamps this frame's events (one clock read per frame). Without threads
+// (single-threaded web builds) it also writes the ring out every so often.
+void beginFrame();
+
+void record(Event type, uint16_t level = kNoLevel, float x = 0.0f, uint32_t a = 0, uint32_t b = 0);
+
+struct Stats {
+  uint64_t recorded = 0;
+  uint64_t dropped = 0;
+  uint64_t written = 0;
+};
+
+Stats stats();
+
+} // namespace telemetry
@@ -1,6 +1,82 @@
 // src/Text.cpp
 #include "Text.h"
 
+#include <string>
+#include <vector>
+
+#include "TextureRegistry.h"
+#include "Trace.h"
+
+namespace {
+
+constexpr size_t kMaxCachedStrings = 48;
+
+struct CachedText {
+  SDL_Renderer* renderer = nullptr;
+  TTF_Font* font = nullptr;
+  Uint32 color = 0;
+  std::string text;
+  SDL_Texture* tex = nullptr;
+  int w = 0;
+  int h = 0;
+  Uint64 lastUse = 0;
+};
+
+std::vector<CachedText> gCache;
+Uint64 gUseClock = 0;
+
+Uint32 packColor(SDL_Color c) {
+  return (Uint32)c.r | (Uint32)c.g << 8 | (Uint32)c.b << 16 | (Uint32)c.a << 24;
+}
+
+// Cached texture for the string, rendered on a miss (null on failure).
+const CachedText* lookup(SDL_Renderer* renderer, TTF_Font* font, const char* text, SDL_Color color) {
+  const Uint32 key = packColor(color);
+  for (CachedText& c : gCache) {
+    if (c.renderer == renderer && c.font == font && c.color == key && c.text == text) {
+      c.lastUse = ++gUseClock;
+      return &c;
+    }
+  }
+
+  TRACE_SCOPE("drawTextCentered render");
+  SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, color);
+  if (!surf) return nullptr;
+  SDL_Texture* tex = textures::createFromSurface(renderer, surf, "text");
+  const int w = surf->w, h = surf->h;
+  SDL_FreeSurface(surf);
+  if (!tex) return nullptr;
+
+  // full: reuse the least recently drawn slot
+  CachedText* slot = nullptr;
+  if (gCache.size() < kMaxCachedStrings) {
+    slot = &gCache.emplace_back();
+  } else {
+    slot = &gCache[0];
+    for (CachedText& c : gCache) {
+      if (c.lastUse < slot->lastUse) slot = &c;
+    }
+    textures::destroy(slot->tex);
+  }
+
+  slot->renderer = renderer;
+  slot->font = font;
+  slot->color = key;
+  slot->text = text;
+  slot->tex = tex;
+  slot->w = w;
+  slot->h = h;
+  slot->lastUse = ++gUseClock;
+  return slot;
+}
+
+} // namespace
+
+void clearTextCache() {
+  for (CachedText& c : gCache) textures::destroy(c.tex);
+  gCache.clear();
+}
+
 static void drawTextCenteredImpl(
   SDL_Renderer* renderer,
   TTF_Font* font,
@@ -10,25 +86,16 @@ static void drawTextCenteredImpl(
 ) {
   if (!renderer || !font || !text || !text[0]) return;
 
-  SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text, color);
-  if (!surf) return;
-
-  SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-  if (!tex) {
-    SDL_FreeSurface(surf);
-    return;
-  }
+  const CachedText* c = lookup(renderer, font, text, color);
+  if (!c) return;
 
   SDL_FRect dst;
-  dst.w = (float)surf->w;
-  dst.h = (float)surf->h;
+  dst.w = (float)c->w;
+  dst.h = (float)c->h;
   dst.x = box.x + (box.w - dst.w) * 0.5f;
   dst.y = box.y + (box.h - dst.h) * 0.5f;
 
-  SDL_FreeSurface(surf);
-
-  SDL_RenderCopyF(renderer, tex, nullptr, &dst);
-  SDL_DestroyTexture(tex);
+  SDL_RenderCopyF(renderer, c->tex, nullptr, &dst);
 }
 
 void drawTextCentered(
@@ -19,3 +19,9 @@ void drawTextCentered(
   const SDL_FRect& box,
   SDL_Color color
 );
+
+// Rendered strings are cached as textures (keyed by renderer, font, color
+// and text; least recently used dropped past a few dozen), so static HUD
+// text costs one copy per frame. Call before destroying a renderer or a
+// font that text was drawn with.
+void clearTextCache();
@@ -0,0 +1,243 @@
+// src/TextureRegistry.cpp
+#include "TextureRegistry.h"
+
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+
+#include "Log.h"
+
+namespace textures {
+
+namespace {
+
+struct Record {
+  SDL_Renderer* renderer = nullptr;
+  std::string label;
+  Uint32 format = 0;
+  int w = 0;
+  int h = 0;
+  size_t bytes = 0;
+  int downscale = 0; // number of halvings applied
+};
+
+struct Registry {
+  std::unordered_map<SDL_Texture*, Record> records;
+  Stats stats;
+  bool budgetInitialized = false;
+};
+
+Registry& reg() {
+  static Registry r;
+  return r;
+}
+
+size_t defaultBudget() {
+  if (const char* env = std::getenv("GAME_TEXTURE_BUDGET_MB")) {
+    return (size_t)std::max(0L, std::atol(env)) * 1024 * 1024;
+  }
+#ifdef __EMSCRIPTEN__
+  return (size_t)64 * 1024 * 1024;
+#else
+  return 0;
+#endif
+}
+
+void ensureBudget() {
+  Registry& g = reg();
+  if (g.budgetInitialized) return;
+  g.budgetInitialized = true;
+  g.stats.budgetBytes = defaultBudget();
+}
+
+size_t estimateBytes(Uint32 format, int w, int h) {
+  int bpp = SDL_BYTESPERPIXEL(format);
+  if (bpp <= 0) bpp = 4;
+  return (size_t)w * (size_t)h * (size_t)bpp;
+}
+
+SDL_Texture* track(SDL_Renderer* r, SDL_Texture* tex, const char* label, int downscale) {
+  if (!tex) return nullptr;
+
+  Record rec;
+  rec.renderer = r;
+  rec.label = label ? label : "";
+  SDL_QueryTexture(tex, &rec.format, nullptr, &rec.w, &rec.h);
+  rec.bytes = estimateBytes(rec.format, rec.w, rec.h);
+  rec.downscale = downscale;
+
+  Stats& s = reg().stats;
+  s.liveBytes += rec.bytes;
+  s.peakBytes = std::max(s.peakBytes, s.liveBytes);
+  s.count += 1;
+  if (downscale > 0) s.downscaledCount += 1;
+
+  reg().records[tex] = std::move(rec);
+  return tex;
+}
+
+void untrack(const Record& rec) {
+  Stats& s = reg().stats;
+  s.liveBytes -= std::min(s.liveBytes, rec.bytes);
+  s.count -= 1;
+  if (rec.downscale > 0) s.downscaledCount -= 1;
+}
+
+// 2x2 box filter into a new ARGB8888 surface of half the size.
+SDL_Surface* halve(SDL_Surface* src) {
+  SDL_Surface* in = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+  if (!in) return nullptr;
+
+  const int w = std::max(1, in->w / 2);
+  const int h = std::max(1, in->h / 2);
+  SDL_Surface* out = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (!out) {
+    SDL_FreeSurface(in);
+    return nullptr;
+  }
+
+  SDL_LockSurface(in);
+  SDL_LockSurface(out);
+  for (int y = 0; y < h; ++y) {
+    const Uint32* row0 = (const Uint32*)((const Uint8*)in->pixels + (size_t)std::min(2 * y, in->h - 1) * in->pitch);
+    const Uint32* row1 = (const Uint32*)((const Uint8*)in->pixels + (size_t)std::min(2 * y + 1, in->h - 1) * in->pitch);
+    Uint32* dst = (Uint32*)((Uint8*)out->pixels + (size_t)y * out->pitch);
+
+    for (int x = 0; x < w; ++x) {
+      const int x0 = std::min(2 * x, in->w - 1);
+      const int x1 = std::min(2 * x + 1, in->w - 1);
+      const Uint32 p[4] = { row0[x0], row0[x1], row1[x0], row1[x1] };
+
+      Uint32 px = 0;
+      for (int c = 0; c < 32; c += 8) {
+        const Uint32 sum = ((p[0] >> c) & 0xFF) + ((p[1] >> c) & 0xFF) +
+                           ((p[2] >> c) & 0xFF) + ((p[3] >> c) & 0xFF);
+        px |= ((sum + 2) / 4) << c;
+      }
+      dst[x] = px;
+    }
+  }
+  SDL_UnlockSurface(out);
+  SDL_UnlockSurface(in);
+  SDL_FreeSurface(in);
+  return out;
+}
+
+} // namespace
+
+void setBudget(size_t bytes) {
+  ensureBudget();
+  reg().stats.budgetBytes = bytes;
+}
+
+size_t budget() {
+  ensureBudget();
+  return reg().stats.budgetBytes;
+}
+
+SDL_Texture* load(SDL_Renderer* r, const char* path) {
+  if (!r || !path) return nullptr;
+
+  SDL_Surface* surf = IMG_Load(path);
+  if (!surf) {
+    LOG_ERROR("IMG_Load failed (%s): %s", path, IMG_GetError());
+    return nullptr;
+  }
+
+  SDL_Texture* tex = createWithinBudget(r, surf, path, nullptr);
+  SDL_FreeSurface(surf);
+  return tex;
+}
+
+SDL_Texture* createWithinBudget(SDL_Renderer* r, SDL_Surface* surf, const char* label, int* halvingsOut) {
+  if (halvingsOut) *halvingsOut = 0;
+  if (!r || !surf) return nullptr;
+  ensureBudget();
+
+  // Downscale until the upload fits what's left of the budget.
+  const Stats& s = reg().stats;
+  SDL_Surface* upload = surf; // becomes an owned copy once we start halving
+  int halvings = 0;
+
+  while (s.budgetBytes > 0 && halvings < kMaxHalvings && upload->w > 1 && upload->h > 1 &&
+         s.liveBytes + estimateBytes(SDL_PIXELFORMAT_ARGB8888, upload->w, upload->h) > s.budgetBytes) {
+    SDL_Surface* smaller = halve(upload);
+    if (!smaller) break;
+    if (upload != surf) SDL_FreeSurface(upload);
+    upload = smaller;
+    ++halvings;
+  }
+
+  if (halvings > 0) {
+    LOG_WARN("Texture budget: %s downscaled 1/%d (%dx%d)", label ? label : "?", 1 << halvings, upload->w, upload->h);
+  }
+
+  SDL_Texture* tex = SDL_CreateTextureFromSurface(r, upload);
+  if (upload != surf) SDL_FreeSurface(upload);
+  if (!tex) {
+    LOG_ERROR("SDL_CreateTextureFromSurface failed (%s): %s", label ? label : "?", SDL_GetError());
+    return nullptr;
+  }
+
+  if (halvingsOut) *halvingsOut = halvings;
+  return track(r, tex, label, halvings);
+}
+
+SDL_Texture* createFromSurface(SDL_Renderer* r, SDL_Surface* surf, const char* label) {
+  if (!r || !surf) return nullptr;
+  return track(r, SDL_CreateTextureFromSurface(r, surf), label, 0);
+}
+
+SDL_Texture* create(SDL_Renderer* r, Uint32 format, int access, int w, int h, const char* label) {
+  if (!r) return nullptr;
+  return track(r, SDL_CreateTexture(r, format, access, w, h), label, 0);
+}
+
+void destroy(SDL_Texture*& tex) {
+  if (!tex) return;
+
+  auto& records = reg().records;
+  auto it = records.find(tex);
+  if (it != records.end()) {
+    untrack(it->second);
+    records.erase(it);
+    SDL_DestroyTexture(tex);
+  }
+  tex = nullptr;
+}
+
+void forgetRenderer(SDL_Renderer* r) {
+  auto& records = reg().records;
+  for (auto it = records.begin(); it != records.end();) {
+    if (it->second.renderer == r) {
+      untrack(it->second);
+      it = records.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+Stats stats() {
+  ensureBudget();
+  return reg().stats;
+}
+
+void printReport() {
+  const Stats s = stats();
+  std::printf("Textures: %d live, %.1f MB (peak %.1f MB, budget %s)\n",
+              s.count, s.liveBytes / 1048576.0, s.peakBytes / 1048576.0,
+              s.budgetBytes ? (std::to_string(s.budgetBytes / 1048576) + " MB").c_str() : "none");
+
+  for (const auto& kv : reg().records) {
+    const Record& rec = kv.second;
+    std::printf("  %-40s %5dx%-5d %-8s %7.2f MB%s\n", rec.label.c_str(), rec.w, rec.h,
+                SDL_GetPixelFormatName(rec.format), rec.bytes / 1048576.0,
+                rec.downscale ? " (downscaled)" : "");
+  }
+}
+
+} // namespace textures
@@ -0,0 +1,56 @@
+// src/TextureRegistry.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+// Central bookkeeping for every SDL_Texture the game creates: format,
+// size and estimated memory, live totals and the high-water mark, plus an
+// optional budget. Asset loads that would exceed the budget are uploaded
+// as downscaled (box-filtered) variants instead; draw code keeps working
+// because it derives frame sizes from SDL_QueryTexture.
+namespace textures {
+
+struct Stats {
+  size_t liveBytes = 0;
+  size_t peakBytes = 0;
+  size_t budgetBytes = 0; // 0 = unlimited
+  int count = 0;
+  int downscaledCount = 0;
+};
+
+// Most halvings createWithinBudget applies (1/8 size).
+constexpr int kMaxHalvings = 3;
+
+// 0 disables the budget. Default: GAME_TEXTURE_BUDGET_MB from the
+// environment, else 64 MB on web and unlimited on native.
+void setBudget(size_t bytes);
+size_t budget();
+
+// IMG_Load + upload, halving the image (up to kMaxHalvings times) while it would not
+// fit in the remaining budget. Returns nullptr on failure (logged).
+SDL_Texture* load(SDL_Renderer* r, const char* path);
+
+// Upload a surface (not consumed), halving it first like load() while it
+// would not fit. `halvingsOut` (optional) receives how many halvings were
+// applied so callers holding pixel rects can scale them.
+SDL_Texture* createWithinBudget(SDL_Renderer* r, SDL_Surface* surf, const char* label, int* halvingsOut);
+
+// Upload an existing surface as-is (text, generated images).
+SDL_Texture* createFromSurface(SDL_Renderer* r, SDL_Surface* surf, const char* label);
+
+// Blank texture (render targets, streaming).
+SDL_Texture* create(SDL_Renderer* r, Uint32 format, int access, int w, int h, const char* label);
+
+// Destroys and unregisters. Textures already freed along with their
+// renderer (see forgetRenderer) are only cleared, never double-freed.
+void destroy(SDL_Texture*& tex);
+
+// Call right before SDL_DestroyRenderer: SDL frees that renderer's
+// textures itself, so drop their records.
+void forgetRenderer(SDL_Renderer* r);
+
+Stats stats();
+void printReport(); // one line per texture + totals (stdout)
+
+} // namespace textures
@@ -0,0 +1,126 @@
+// src/Trace.cpp
+#include "Trace.h"
+
+#ifdef GAME_ENABLE_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trace {
+
+namespace {
+
+struct Event {
+  const char* name;
+  uint64_t startNs;
+  uint64_t durNs;
+};
+
+// One per thread; only the owning thread writes. When full the oldest
+// events are overwritten, so a capture holds the most recent history.
+struct ThreadRing {
+  static constexpr uint32_t kCapacity = 1u << 15; // 32k events, 768 KB
+
+  std::vector<Event> events = std::vector<Event>(kCapacity);
+  std::atomic<uint64_t> written{ 0 };
+  uint32_t tid = 0;
+  std::string name;
+};
+
+std::mutex gRingsMutex;
+std::vector<std::unique_ptr<ThreadRing>> gRings; // never shrinks
+const uint64_t gEpochNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+  std::chrono::steady_clock::now().time_since_epoch()).count();
+
+ThreadRing& localRing() {
+  thread_local ThreadRing* ring = nullptr;
+  if (!ring) {
+    std::lock_guard<std::mutex> lock(gRingsMutex);
+    gRings.push_back(std::make_unique<ThreadRing>());
+    ring = gRings.back().get();
+    ring->tid = (uint32_t)gRings.size();
+  }
+  return *ring;
+}
+
+void writeJsonString(std::FILE* f, const char* s) {
+  std::fputc('"', f);
+  for (; s && *s; ++s) {
+    if (*s == '"' || *s == '\\') std::fputc('\\', f);
+    if ((unsigned char)*s >= 0x20) std::fputc(*s, f);
+  }
+  std::fputc('"', f);
+}
+
+} // namespace
+
+uint64_t nowNs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count() - gEpochNs;
+}
+
+void record(const char* name, uint64_t startNs, uint64_t endNs) {
+  ThreadRing& ring = localRing();
+  const uint64_t n = ring.written.load(std::memory_order_relaxed);
+  ring.events[n & (ThreadRing::kCapacity - 1)] = Event{ name, startNs, endNs - startNs };
+  ring.written.store(n + 1, std::memory_order_release);
+}
+
+void setThreadName(const char* name) {
+  localRing().name = name ? name : "";
+}
+
+bool writeChromeJson(const char* path) {
+  std::FILE* f = path ? std::fopen(path, "w") : nullptr;
+  if (!f) return false;
+
+  std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  bool first = true;
+
+  std::lock_guard<std::mutex> lock(gRingsMutex);
+  for (const auto& ring : gRings) {
+    if (!ring->name.empty()) {
+      std::fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                   first ? "" : ",\n", ring->tid);
+      writeJsonString(f, ring->name.c_str());
+      std::fprintf(f, "}}");
+      first = false;
+    }
+
+    // Skip the oldest quarter of a wrapped ring: the owner may be
+    // overwriting it while we read.
+    const uint64_t end = ring->written.load(std::memory_order_acquire);
+    uint64_t begin = 0;
+    if (end > ThreadRing::kCapacity) begin = end - ThreadRing::kCapacity * 3 / 4;
+
+    for (uint64_t i = begin; i < end; ++i) {
+      const Event& e = ring->events[i & (ThreadRing::kCapacity - 1)];
+      std::fprintf(f, "%s{\"ph\":\"X\",\"name\":", first ? "" : ",\n");
+      writeJsonString(f, e.name);
+      std::fprintf(f, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                   ring->tid, e.startNs / 1000.0, e.durNs / 1000.0);
+      first = false;
+    }
+  }
+
+  std::fprintf(f, "\n]}\n");
+  return std::fclose(f) == 0;
+}
+
+} // namespace trace
+
+#else
+
+namespace trace {
+
+bool writeChromeJson(const char*) { return false; }
+void setThreadName(const char*) {}
+
+} // namespace trace
+
+#endif
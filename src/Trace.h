@@ -0,0 +1,53 @@
+// src/Trace.h
+#pragma once
+
+#include <cstdint>
+
+// Scoped timeline profiling, exported as Chrome trace-event JSON (open in
+// Perfetto or chrome://tracing).
+//
+//   void Foo::bar() {
+//     TRACE_SCOPE("Foo::bar");
+//     ...
+//   }
+//
+// Build with GAME_ENABLE_TRACE defined (CMake: -DGAME_TRACE=ON) to record.
+// Otherwise TRACE_SCOPE expands to nothing and the functions below are
+// empty stubs.
+namespace trace {
+
+// Writes everything currently held in the per-thread ring buffers.
+// Returns false if tracing is compiled out or the file can't be written.
+bool writeChromeJson(const char* path);
+
+// Names the calling thread in the exported timeline.
+void setThreadName(const char* name);
+
+#ifdef GAME_ENABLE_TRACE
+
+uint64_t nowNs();
+void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+class Scope {
+public:
+  explicit Scope(const char* name) : m_name(name), m_start(nowNs()) {}
+  ~Scope() { record(m_name, m_start, nowNs()); }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  const char* m_name; // must be a string literal (stored by pointer)
+  uint64_t m_start;
+};
+
+#endif
+
+} // namespace trace
+
+#ifdef GAME_ENABLE_TRACE
+  #define TRACE_CONCAT_INNER(a, b) a##b
+  #define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+  #define TRACE_SCOPE(name) ::trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+  #define TRACE_SCOPE(name) do {} while (0)
+#endif
@@ -3,6 +3,11 @@
 
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define ZOOM_SSE2 1
+#endif
+
 namespace zoom {
 
 static inline float applyAnchorY(const Camera& c, float worldY) {
@@ -12,6 +17,11 @@ static inline float applyAnchorY(const Camera& c, float worldY) {
   return (worldY - c.anchorWorldY);
 }
 
+// Screen y of world y = 0 after scaling (so y' = y * zoom + offsetY).
+static inline float offsetY(const Camera& c) {
+  return c.useAnchorY ? c.anchorScreenY - c.anchorWorldY * c.zoom : 0.0f;
+}
+
 SDL_FRect worldToScreen(const Camera& c, const SDL_FRect& world) {
   SDL_FRect out{};
 
@@ -20,7 +30,7 @@ SDL_FRect worldToScreen(const Camera& c, const SDL_FRect& world) {
 
   // Y can be anchored or not
   const float yBase = applyAnchorY(c, world.y);
-  out.y = yBase * c.zoom;
+  out.y = yBase * c.zoom + (c.useAnchorY ? c.anchorScreenY : 0.0f);
 
   out.w = world.w * c.zoom;
   out.h = world.h * c.zoom;
@@ -44,7 +54,111 @@ float worldXToScreen(const Camera& c, float worldX) {
 
 float worldYToScreen(const Camera& c, float worldY) {
   const float yBase = applyAnchorY(c, worldY);
-  return yBase * c.zoom;
+  return yBase * c.zoom + (c.useAnchorY ? c.anchorScreenY : 0.0f);
+}
+
+// -----------------------------
+// Batch transforms
+// -----------------------------
+// Every rect maps as (x, y, w, h) * zoom + (-camX * zoom, offsetY, 0, 0),
+// which is exactly one 4-lane multiply-add per SDL_FRect.
+
+static inline bool visibleScalar(const SDL_FRect& r, const SDL_FRect& view) {
+  return r.x < view.x + view.w && r.x + r.w > view.x &&
+         r.y < view.y + view.h && r.y + r.h > view.y;
+}
+
+int worldToScreenBatch(const Camera& c, const SDL_FRect* firstRect, size_t strideBytes, int count,
+                       const SDL_FRect& view, SDL_FRect* out, int* indices) {
+  if (!firstRect || !out || count <= 0) return 0;
+  const char* base = (const char*)firstRect;
+  int kept = 0;
+
+#ifdef ZOOM_SSE2
+  const __m128 scale = _mm_set1_ps(c.zoom);
+  const __m128 offset = _mm_setr_ps(-c.camX * c.zoom, offsetY(c), 0.0f, 0.0f);
+  // (minX, minY) must be < viewMax and (maxX, maxY) > viewMin
+  const __m128 viewMin = _mm_setr_ps(view.x, view.y, 0.0f, 0.0f);
+  const __m128 viewMax = _mm_setr_ps(view.x + view.w, view.y + view.h, 0.0f, 0.0f);
+
+  for (int i = 0; i < count; ++i) {
+    const __m128 world = _mm_loadu_ps((const float*)(base + (size_t)i * strideBytes));
+    const __m128 screen = _mm_add_ps(_mm_mul_ps(world, scale), offset);
+
+    // (x + w, y + h) in the low lanes
+    const __m128 maxXY = _mm_add_ps(screen, _mm_movehl_ps(screen, screen));
+    const int mask = _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(screen, viewMax), _mm_cmpgt_ps(maxXY, viewMin)));
+    if ((mask & 0x3) != 0x3) continue;
+
+    _mm_storeu_ps((float*)&out[kept], screen);
+    if (indices) indices[kept] = i;
+    ++kept;
+  }
+#else
+  const float ox = -c.camX * c.zoom;
+  const float oy = offsetY(c);
+  for (int i = 0; i < count; ++i) {
+    const SDL_FRect& w = *(const SDL_FRect*)(base + (size_t)i * strideBytes);
+    const SDL_FRect s { w.x * c.zoom + ox, w.y * c.zoom + oy, w.w * c.zoom, w.h * c.zoom };
+    if (!visibleScalar(s, view)) continue;
+    out[kept] = s;
+    if (indices) indices[kept] = i;
+    ++kept;
+  }
+#endif
+  return kept;
+}
+
+int worldToScreenBatch(const Camera& c, const RectArrays& world, int count,
+                       const SDL_FRect& view, SDL_FRect* out, int* indices) {
+  if (!world.x || !world.y || !world.w || !world.h || !out || count <= 0) return 0;
+  const float ox = -c.camX * c.zoom;
+  const float oy = offsetY(c);
+  int kept = 0;
+  int i = 0;
+
+#ifdef ZOOM_SSE2
+  const __m128 scale = _mm_set1_ps(c.zoom);
+  const __m128 vox = _mm_set1_ps(ox);
+  const __m128 voy = _mm_set1_ps(oy);
+  const __m128 viewL = _mm_set1_ps(view.x);
+  const __m128 viewT = _mm_set1_ps(view.y);
+  const __m128 viewR = _mm_set1_ps(view.x + view.w);
+  const __m128 viewB = _mm_set1_ps(view.y + view.h);
+
+  for (; i + 4 <= count; i += 4) {
+    __m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(world.x + i), scale), vox);
+    __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(world.y + i), scale), voy);
+    __m128 w = _mm_mul_ps(_mm_loadu_ps(world.w + i), scale);
+    __m128 h = _mm_mul_ps(_mm_loadu_ps(world.h + i), scale);
+
+    const __m128 vis = _mm_and_ps(
+      _mm_and_ps(_mm_cmplt_ps(x, viewR), _mm_cmpgt_ps(_mm_add_ps(x, w), viewL)),
+      _mm_and_ps(_mm_cmplt_ps(y, viewB), _mm_cmpgt_ps(_mm_add_ps(y, h), viewT)));
+    const int mask = _mm_movemask_ps(vis);
+    if (mask == 0) continue;
+
+    // SoA -> AoS: after the transpose each register is one SDL_FRect
+    _MM_TRANSPOSE4_PS(x, y, w, h);
+    const __m128 rects[4] = { x, y, w, h };
+    for (int k = 0; k < 4; ++k) {
+      if (!(mask & (1 << k))) continue;
+      _mm_storeu_ps((float*)&out[kept], rects[k]);
+      if (indices) indices[kept] = i + k;
+      ++kept;
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    const SDL_FRect s { world.x[i] * c.zoom + ox, world.y[i] * c.zoom + oy,
+                        world.w[i] * c.zoom, world.h[i] * c.zoom };
+    if (!visibleScalar(s, view)) continue;
+    out[kept] = s;
+    if (indices) indices[kept] = i;
+    ++kept;
+  }
+  return kept;
 }
 
 } // namespace zoom
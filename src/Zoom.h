@@ -2,6 +2,7 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <cstddef>
 
 namespace zoom {
 
@@ -13,10 +14,12 @@ struct Camera {
   float zoom = 1.0f;
 
   // Optional: anchor the world to a baseline (useful for platformers).
-  // If enabled, y is transformed relative to anchorWorldY so the "ground"
-  // can visually stay consistent when zoom changes.
+  // If enabled, world y = anchorWorldY lands on screen y = anchorScreenY
+  // and everything else scales around it, so the "ground" stays put when
+  // zoom changes.
   bool  useAnchorY = false;
   float anchorWorldY = 0.0f;
+  float anchorScreenY = 0.0f;
 };
 
 // Convert a world-space float rect to a screen-space float rect.
@@ -31,4 +34,35 @@ float worldXToScreen(const Camera& c, float worldX);
 // Helper: convert a world y coordinate to screen y.
 float worldYToScreen(const Camera& c, float worldY);
 
+// -----------------------------
+// Batch transforms
+// -----------------------------
+// Transform many rects in one pass (4-wide SIMD where available) and cull
+// against `view` (screen space) in the same pass. Only rects that overlap
+// `view` are written, packed at the front of `out`; `indices` (optional)
+// receives the source index of each one. Both outputs need room for
+// `count` entries. Returns the number of visible rects.
+
+// Array of structs: the i-th rect is at (const char*)firstRect + i * stride,
+// so rects embedded in larger structs (Obstacle, ecs::Transform) can be
+// passed in place.
+int worldToScreenBatch(const Camera& c, const SDL_FRect* firstRect, size_t strideBytes, int count,
+                       const SDL_FRect& view, SDL_FRect* out, int* indices);
+
+inline int worldToScreenBatch(const Camera& c, const SDL_FRect* rects, int count,
+                              const SDL_FRect& view, SDL_FRect* out, int* indices) {
+  return worldToScreenBatch(c, rects, sizeof(SDL_FRect), count, view, out, indices);
+}
+
+// Structure of arrays.
+struct RectArrays {
+  const float* x = nullptr;
+  const float* y = nullptr;
+  const float* w = nullptr;
+  const float* h = nullptr;
+};
+
+int worldToScreenBatch(const Camera& c, const RectArrays& world, int count,
+                       const SDL_FRect& view, SDL_FRect* out, int* indices);
+
 } // namespace zoom
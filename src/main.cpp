@@ -4,7 +4,14 @@
 #include <SDL2/SDL_image.h>
 #include <cstdio>
 
+#include "Audio.h"
 #include "Game.h"
+#include "Jobs.h"
+#include "Log.h"
+#include "RendererProbe.h"
+#include "Startup.h"
+#include "Telemetry.h"
+#include "Trace.h"
 
 #ifdef __EMSCRIPTEN__
   #include <emscripten.h>
@@ -13,12 +20,14 @@
 struct App {
   SDL_Window* window = nullptr;
   SDL_Renderer* renderer = nullptr;
-  TTF_Font* font = nullptr;
   Game* game = nullptr;
 };
 
 static App gApp;
 
+static constexpr const char* kFontPath = "assets/fonts/DejaVuSans.ttf";
+static constexpr int kFontSize = 28;
+
 static void shutdown_app() {
   // Game owns renderer after construction (your note), so don't destroy renderer here.
   if (gApp.game) {
@@ -26,39 +35,37 @@ static void shutdown_app() {
     gApp.game = nullptr;
   }
 
-  if (gApp.font) {
-    TTF_CloseFont(gApp.font);
-    gApp.font = nullptr;
-  }
-
   if (gApp.window) {
     SDL_DestroyWindow(gApp.window);
     gApp.window = nullptr;
   }
 
+  audio::shutdown();
+  telemetry::shutdown();
+  jobs::shutdown();
   TTF_Quit();
   IMG_Quit();
   SDL_Quit();
+  logging::shutdown(); // last, so nothing logged above is lost
 }
 
+// Staged startup: only what the first frame needs runs before it (SDL,
+// window, renderer). Image support is initialized right after the first
+// present, and the font is opened by Game after its first frame (on a
+// worker where threads exist), so menus appear before text does.
 static bool init_app() {
   if (SDL_Init(SDL_INIT_VIDEO) != 0) {
     std::printf("SDL_Init failed: %s\n", SDL_GetError());
     return false;
   }
-
-  if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-    std::printf("IMG_Init failed: %s\n", IMG_GetError());
-    // Treat as fatal for web reliability
-    shutdown_app();
-    return false;
-  }
+  startup::mark("SDL_Init");
 
   if (TTF_Init() != 0) {
     std::printf("TTF_Init failed: %s\n", TTF_GetError());
     shutdown_app();
     return false;
   }
+  startup::mark("TTF_Init");
 
   gApp.window = SDL_CreateWindow(
     "SDL2 Starter",
@@ -72,28 +79,49 @@ static bool init_app() {
     shutdown_app();
     return false;
   }
+  startup::mark("window");
 
-  gApp.renderer = SDL_CreateRenderer(
-    gApp.window, -1,
-    SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
-  );
+  // Fastest driver for this machine (benchmarked on first launch, then
+  // cached; only a real probe opens the font, for its text pass).
+  renderprobe::chooseDriver(gApp.window, kFontPath, kFontSize);
+  gApp.renderer = renderprobe::createRenderer(gApp.window);
 
   if (!gApp.renderer) {
     std::printf("SDL_CreateRenderer failed: %s\n", SDL_GetError());
     shutdown_app();
     return false;
   }
+  startup::mark("renderer");
 
-  // IMPORTANT: in web builds, assets must be preloaded (CMake adds --preload-file).
-  gApp.font = TTF_OpenFont("assets/fonts/DejaVuSans.ttf", 28);
-  if (!gApp.font) {
-    std::printf("TTF_OpenFont failed: %s\n", TTF_GetError());
+  // First frame: the menu background color, so the window never shows
+  // garbage while the rest loads.
+  SDL_SetRenderDrawColor(gApp.renderer, 12, 12, 16, 255);
+  SDL_RenderClear(gApp.renderer);
+  SDL_RenderPresent(gApp.renderer);
+  startup::mark("first frame");
+
+  if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+    std::printf("IMG_Init failed: %s\n", IMG_GetError());
+    // Treat as fatal for web reliability
     shutdown_app();
     return false;
   }
+  startup::mark("IMG_Init");
+
+  // Not fatal: without a device the game just runs silent.
+  audio::init();
+  startup::mark("audio");
+
+  // Not fatal either: events are simply not recorded.
+  telemetry::init();
+  startup::mark("telemetry");
 
   // IMPORTANT: Game may recreate renderer internally, so it owns renderer after this.
-  gApp.game = new Game(gApp.window, gApp.renderer, gApp.font);
+  gApp.game = new Game(gApp.window, gApp.renderer, nullptr);
+  startup::mark("game");
+
+  // IMPORTANT: in web builds, assets must be preloaded (CMake adds --preload-file).
+  gApp.game->loadFontAsync(kFontPath, kFontSize);
   return true;
 }
 
@@ -101,6 +129,17 @@ static bool init_app() {
 static void em_frame() {
   // One frame per callback (non-blocking)
   gApp.game->tick();
+  logging::pump(); // no log thread here: format a few queued lines per frame
+
+  // Idle: drop from requestAnimationFrame to a slow timer so an open tab
+  // with a static menu costs next to nothing; input restores rAF pacing
+  // within one timer period.
+  static bool idle = false;
+  if (gApp.game->isIdle() != idle) {
+    idle = !idle;
+    if (idle) emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, 100);
+    else      emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+  }
 
   if (!gApp.game->isRunning()) {
     emscripten_cancel_main_loop();
@@ -110,6 +149,11 @@ static void em_frame() {
 #endif
 
 int main(int, char**) {
+  startup::begin();
+  trace::setThreadName("main");
+  logging::init();
+  jobs::init(); // one worker per remaining core; inline on single-threaded web builds
+  startup::mark("jobs");
   if (!init_app()) return 1;
 
 #ifdef __EMSCRIPTEN__
@@ -0,0 +1,395 @@
+// tools/FrameRegress.cpp
+// Golden-frame + frame-time regression check for Menu / Options / Play.
+//
+// Each scenario drives a Game through SDL's software renderer on an
+// offscreen surface with a fixed dt and a fixed random seed, compares
+// selected frames against stored golden BMPs (with a tolerance) and
+// compares the median render+update time against a stored baseline.
+// Needs no window, display or GPU, so it runs on headless CI.
+//
+//   frame_regress [--golden-dir DIR] [--update] [--csv FILE]
+//                 [--pixel-tolerance N] [--max-bad-pixels FRACTION]
+//                 [--no-timing] [--time-regress FRACTION]
+//
+// --update rewrites the goldens and timing baseline instead of checking
+// (creating DIR if needed). Everything that feeds the frames is pinned
+// here: the env overrides, the seed, ghosts and authored level files.
+//
+// Timings are relative: each run first times a fixed blend workload on
+// the same renderer, and scenario medians are scaled by how fast this
+// machine ran it versus the machine that recorded the baseline.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Game.h"
+
+namespace {
+
+constexpr int   kWidth  = 960;
+constexpr int   kHeight = 540;
+constexpr float kDt     = 1.0f / 60.0f;
+constexpr unsigned kSeed = 1234;
+
+struct ScriptKey {
+  int frame;
+  Uint32 type;   // SDL_KEYDOWN / SDL_KEYUP
+  SDL_Keycode key;
+};
+
+struct Scenario {
+  const char* name;
+  Game::SceneId scene;
+  int frames;
+  std::vector<int> captures;
+  std::vector<ScriptKey> script;
+};
+
+struct Options {
+  std::string goldenDir = "tests/golden";
+  std::string csvPath;
+  bool update = false;
+  bool checkTiming = true;
+  int pixelTolerance = 8;        // per-channel difference still counted as equal
+  double maxBadPixels = 0.002;   // fraction of pixels allowed above tolerance
+  double timeRegress = 1.0;      // allowed median slowdown vs scaled baseline
+};
+
+// Baseline key for the calibration workload (not a scenario name).
+constexpr const char* kCalibrationKey = "calibration";
+
+// Overrides that change what the game renders; pinned so a developer's
+// shell cannot make the goldens differ.
+void pinEnv(const char* name, const char* value) {
+#ifdef _WIN32
+  _putenv_s(name, value ? value : "");
+#else
+  if (value) setenv(name, value, 1);
+  else unsetenv(name);
+#endif
+}
+
+void pinInputs() {
+  pinEnv("GAME_CPU_RENDER", "1");        // CPU compositor, as on any software renderer
+  pinEnv("GAME_TEXTURE_BUDGET_MB", "0"); // no downscaled textures
+  pinEnv("GAME_HITCH_MS", nullptr);      // no report writes inside timed frames
+}
+
+std::vector<Scenario> scenarios() {
+  return {
+    { "menu", Game::SceneId::Menu, 60, { 1, 30, 59 },
+      { { 20, SDL_KEYDOWN, SDLK_DOWN }, { 21, SDL_KEYUP, SDLK_DOWN } } },
+    { "options", Game::SceneId::Options, 30, { 1, 29 }, {} },
+    { "play", Game::SceneId::Play, 240, { 1, 60, 120, 239 },
+      { { 0, SDL_KEYDOWN, SDLK_RIGHT },
+        { 40, SDL_KEYDOWN, SDLK_SPACE }, { 41, SDL_KEYUP, SDLK_SPACE },
+        { 90, SDL_KEYDOWN, SDLK_DOWN }, { 120, SDL_KEYUP, SDLK_DOWN } } },
+  };
+}
+
+SDL_Event makeKey(Uint32 type, SDL_Keycode key) {
+  SDL_Event e{};
+  e.type = type;
+  e.key.type = type;
+  e.key.repeat = 0;
+  e.key.keysym.sym = key;
+  return e;
+}
+
+bool readPixels(SDL_Renderer* r, std::vector<Uint32>& out) {
+  out.resize((size_t)kWidth * kHeight);
+  return SDL_RenderReadPixels(r, nullptr, SDL_PIXELFORMAT_RGBA32, out.data(), kWidth * 4) == 0;
+}
+
+bool saveBmp(const std::string& path, std::vector<Uint32>& px) {
+  SDL_Surface* s = SDL_CreateRGBSurfaceWithFormatFrom(px.data(), kWidth, kHeight, 32, kWidth * 4,
+                                                      SDL_PIXELFORMAT_RGBA32);
+  if (!s) return false;
+  const bool ok = SDL_SaveBMP(s, path.c_str()) == 0;
+  SDL_FreeSurface(s);
+  return ok;
+}
+
+bool loadBmp(const std::string& path, std::vector<Uint32>& out) {
+  SDL_Surface* raw = SDL_LoadBMP(path.c_str());
+  if (!raw) return false;
+  SDL_Surface* s = SDL_ConvertSurfaceFormat(raw, SDL_PIXELFORMAT_RGBA32, 0);
+  SDL_FreeSurface(raw);
+  if (!s) return false;
+
+  bool ok = (s->w == kWidth && s->h == kHeight);
+  if (ok) {
+    out.resize((size_t)kWidth * kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+      std::memcpy(&out[(size_t)y * kWidth], (const Uint8*)s->pixels + (size_t)y * s->pitch, kWidth * 4);
+    }
+  }
+  SDL_FreeSurface(s);
+  return ok;
+}
+
+// Fraction of pixels where any channel differs by more than `tolerance`.
+double badPixelFraction(const std::vector<Uint32>& a, const std::vector<Uint32>& b, int tolerance) {
+  size_t bad = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    const Uint32 x = a[i], y = b[i];
+    for (int c = 0; c < 32; c += 8) {
+      const int d = (int)((x >> c) & 0xFF) - (int)((y >> c) & 0xFF);
+      if (d > tolerance || d < -tolerance) { ++bad; break; }
+    }
+  }
+  return a.empty() ? 0.0 : (double)bad / (double)a.size();
+}
+
+double median(std::vector<double> v) {
+  if (v.empty()) return 0.0;
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+std::map<std::string, double> loadBaseline(const std::string& path) {
+  std::map<std::string, double> out;
+  std::FILE* f = std::fopen(path.c_str(), "r");
+  if (!f) return out;
+  char name[64];
+  double ms = 0.0;
+  while (std::fscanf(f, "%63s %lf", name, &ms) == 2) out[name] = ms;
+  std::fclose(f);
+  return out;
+}
+
+// Median time of a fixed workload (clear + blended fills) on a fresh
+// software renderer. Used to scale the timing baseline to this machine.
+double calibrationMs() {
+  SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, kWidth, kHeight, 32, SDL_PIXELFORMAT_RGBA32);
+  SDL_Renderer* ren = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+  if (!ren) {
+    if (target) SDL_FreeSurface(target);
+    return 0.0;
+  }
+
+  SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+  const double freq = (double)SDL_GetPerformanceFrequency();
+  std::vector<double> times;
+  for (int pass = 0; pass < 31; ++pass) {
+    const Uint64 t0 = SDL_GetPerformanceCounter();
+    SDL_SetRenderDrawColor(ren, 20, 24, 32, 255);
+    SDL_RenderClear(ren);
+    for (int i = 0; i < 200; ++i) {
+      const SDL_Rect rc{ (i * 37) % (kWidth - 120), (i * 53) % (kHeight - 90), 120, 90 };
+      SDL_SetRenderDrawColor(ren, (Uint8)(i * 7), (Uint8)(i * 13), (Uint8)(i * 29), 128);
+      SDL_RenderFillRect(ren, &rc);
+    }
+    SDL_RenderFlush(ren);
+    times.push_back((double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / freq);
+  }
+
+  SDL_DestroyRenderer(ren);
+  SDL_FreeSurface(target);
+  return median(times);
+}
+
+// Runs one scenario. Returns false on any image/timing failure.
+bool runScenario(const Scenario& sc, TTF_Font* font, const Options& opt,
+                 std::map<std::string, double>& baseline, double speed, std::FILE* csv) {
+  SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, kWidth, kHeight, 32, SDL_PIXELFORMAT_RGBA32);
+  SDL_Renderer* ren = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+  if (!ren) {
+    std::printf("[%s] software renderer failed: %s\n", sc.name, SDL_GetError());
+    if (target) SDL_FreeSurface(target);
+    return false;
+  }
+
+  bool ok = true;
+  std::vector<double> times;
+  times.reserve(sc.frames);
+
+  {
+    Game game(nullptr, ren, font); // takes ownership of ren
+    game.setRandomSeed(kSeed);
+    game.setGhostsEnabled(false);     // goldens must not depend on saved runs
+    game.setLevelFilesEnabled(false); // ... or on hand-edited layouts
+    game.requestScene(sc.scene);
+    game.stepFrame(0.0f); // applies the scene change
+
+    const double freq = (double)SDL_GetPerformanceFrequency();
+    std::vector<Uint32> frame, golden;
+
+    for (int i = 0; i < sc.frames; ++i) {
+      for (const ScriptKey& k : sc.script) {
+        if (k.frame == i) game.injectEvent(makeKey(k.type, k.key));
+      }
+
+      const Uint64 t0 = SDL_GetPerformanceCounter();
+      game.stepFrame(kDt);
+      SDL_RenderFlush(ren);
+      const double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / freq;
+      times.push_back(ms);
+      if (csv) std::fprintf(csv, "%s,%d,%.4f\n", sc.name, i, ms);
+
+      if (std::find(sc.captures.begin(), sc.captures.end(), i) == sc.captures.end()) continue;
+
+      if (!readPixels(ren, frame)) {
+        std::printf("[%s] frame %d: SDL_RenderReadPixels failed: %s\n", sc.name, i, SDL_GetError());
+        ok = false;
+        continue;
+      }
+
+      const std::string path = opt.goldenDir + "/" + sc.name + "_" + std::to_string(i) + ".bmp";
+      if (opt.update) {
+        if (!saveBmp(path, frame)) {
+          std::printf("[%s] cannot write %s: %s\n", sc.name, path.c_str(), SDL_GetError());
+          ok = false;
+        }
+        continue;
+      }
+
+      if (!loadBmp(path, golden)) {
+        std::printf("[%s] missing/invalid golden %s (run with --update)\n", sc.name, path.c_str());
+        ok = false;
+        continue;
+      }
+
+      const double bad = badPixelFraction(frame, golden, opt.pixelTolerance);
+      if (bad > opt.maxBadPixels) {
+        std::printf("[%s] frame %d differs: %.3f%% pixels over tolerance\n", sc.name, i, bad * 100.0);
+        saveBmp(opt.goldenDir + "/" + sc.name + "_" + std::to_string(i) + ".actual.bmp", frame);
+        ok = false;
+      }
+    }
+  }
+
+  SDL_FreeSurface(target);
+
+  const double med = median(times);
+  const double worst = times.empty() ? 0.0 : *std::max_element(times.begin(), times.end());
+  std::printf("[%s] %d frames, median %.3f ms, worst %.3f ms\n", sc.name, sc.frames, med, worst);
+
+  if (opt.update) {
+    baseline[sc.name] = med;
+  } else if (opt.checkTiming) {
+    auto it = baseline.find(sc.name);
+    if (it == baseline.end()) {
+      std::printf("[%s] no timing baseline (run with --update)\n", sc.name);
+      ok = false;
+    } else {
+      const double expected = it->second * speed;
+      // 0.25 ms of slack keeps sub-millisecond scenes from flapping
+      if (med > expected * (1.0 + opt.timeRegress) + 0.25) {
+        std::printf("[%s] frame time regressed: %.3f ms vs scaled baseline %.3f ms\n", sc.name, med, expected);
+        ok = false;
+      }
+    }
+  }
+
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (a == "--update") opt.update = true;
+    else if (a == "--no-timing") opt.checkTiming = false;
+    else if (a == "--golden-dir" && hasValue) opt.goldenDir = argv[++i];
+    else if (a == "--csv" && hasValue) opt.csvPath = argv[++i];
+    else if (a == "--pixel-tolerance" && hasValue) opt.pixelTolerance = std::atoi(argv[++i]);
+    else if (a == "--max-bad-pixels" && hasValue) opt.maxBadPixels = std::atof(argv[++i]);
+    else if (a == "--time-regress" && hasValue) opt.timeRegress = std::atof(argv[++i]);
+    else {
+      std::printf("unknown argument: %s\n", a.c_str());
+      return 2;
+    }
+  }
+
+  pinInputs();
+
+  // Offscreen only: never try to open a display.
+  SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+  if (SDL_Init(0) != 0) {
+    std::printf("SDL_Init failed: %s\n", SDL_GetError());
+    return 1;
+  }
+  IMG_Init(IMG_INIT_PNG);
+  if (TTF_Init() != 0) {
+    std::printf("TTF_Init failed: %s\n", TTF_GetError());
+    return 1;
+  }
+
+  TTF_Font* font = TTF_OpenFont("assets/fonts/DejaVuSans.ttf", 28);
+  if (!font) {
+    std::printf("TTF_OpenFont failed: %s\n", TTF_GetError());
+    return 1;
+  }
+
+  if (opt.update) {
+    std::error_code ec;
+    std::filesystem::create_directories(opt.goldenDir, ec);
+    if (ec) {
+      std::printf("cannot create %s: %s\n", opt.goldenDir.c_str(), ec.message().c_str());
+      return 1;
+    }
+  }
+
+  std::FILE* csv = opt.csvPath.empty() ? nullptr : std::fopen(opt.csvPath.c_str(), "w");
+  if (csv) std::fprintf(csv, "scene,frame,ms\n");
+
+  const std::string baselinePath = opt.goldenDir + "/timings.txt";
+  std::map<std::string, double> baseline = loadBaseline(baselinePath);
+
+  bool ok = true;
+
+  // speed > 1 means this machine is slower than the one that recorded the
+  // baseline; scenario baselines are multiplied by it.
+  double speed = 1.0;
+  if (opt.update || opt.checkTiming) {
+    const double calib = calibrationMs();
+    std::printf("[%s] median %.3f ms\n", kCalibrationKey, calib);
+    if (opt.update) {
+      baseline[kCalibrationKey] = calib;
+    } else {
+      auto it = baseline.find(kCalibrationKey);
+      if (calib <= 0.0 || it == baseline.end() || it->second <= 0.0) {
+        std::printf("no calibration in %s (run with --update)\n", baselinePath.c_str());
+        ok = false;
+      } else {
+        speed = calib / it->second;
+      }
+    }
+  }
+
+  for (const Scenario& sc : scenarios()) ok = runScenario(sc, font, opt, baseline, speed, csv) && ok;
+
+  if (opt.update) {
+    std::FILE* f = std::fopen(baselinePath.c_str(), "w");
+    if (f) {
+      for (const auto& kv : baseline) std::fprintf(f, "%s %.4f\n", kv.first.c_str(), kv.second);
+      std::fclose(f);
+    } else {
+      std::printf("cannot write %s\n", baselinePath.c_str());
+      ok = false;
+    }
+  }
+
+  if (csv) std::fclose(csv);
+  TTF_CloseFont(font);
+  TTF_Quit();
+  IMG_Quit();
+  SDL_Quit();
+
+  std::printf(ok ? "frame_regress: PASS\n" : "frame_regress: FAIL\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+// tools/TelemetryReport.cpp
+// Offline aggregation of gameplay telemetry (.btel files, see Telemetry.h).
+//
+// Per level: attempts, deaths, completions, completion times and a heat
+// map of where players get caught, bucketed by level x. Also prints event
+// totals and session lengths.
+//
+//   telemetry_report [--bucket PX] [--csv FILE] FILE...
+//
+// --csv writes every death as level,x,run_ms,file for external plotting.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Telemetry.h"
+
+namespace {
+
+const char* eventName(uint16_t type) {
+  switch ((telemetry::Event)type) {
+    case telemetry::Event::SceneChange:     return "scene change";
+    case telemetry::Event::RendererRebuild: return "renderer rebuild";
+    case telemetry::Event::LevelStart:      return "level start";
+    case telemetry::Event::Death:           return "death";
+    case telemetry::Event::LevelComplete:   return "level complete";
+    case telemetry::Event::Jump:            return "jump";
+    case telemetry::Event::Duck:            return "duck";
+    default:                                return "unknown";
+  }
+}
+
+struct LevelStats {
+  int deaths = 0;
+  int completions = 0;
+  std::vector<double> completionSec;
+  std::map<int, int> deathBuckets; // bucket index -> deaths
+};
+
+double median(std::vector<double> v) {
+  if (v.empty()) return 0.0;
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+// Reads one file; returns false (and says why) if it is not telemetry.
+bool readFile(const char* path, telemetry::FileHeader& h, std::vector<telemetry::Record>& out) {
+  std::FILE* f = std::fopen(path, "rb");
+  if (!f) {
+    std::printf("%s: cannot open\n", path);
+    return false;
+  }
+
+  bool ok = std::fread(&h, sizeof(h), 1, f) == 1 &&
+            std::memcmp(h.magic, telemetry::kMagic, sizeof(telemetry::kMagic)) == 0;
+  if (!ok) std::printf("%s: not a telemetry file\n", path);
+  else if (h.version != telemetry::kVersion || h.recordSize != sizeof(telemetry::Record) ||
+           h.headerSize < sizeof(telemetry::FileHeader)) {
+    std::printf("%s: unsupported version %u\n", path, (unsigned)h.version);
+    ok = false;
+  }
+
+  out.clear();
+  if (ok) {
+    std::fseek(f, (long)h.headerSize, SEEK_SET);
+    telemetry::Record r;
+    // a session that crashed mid-write just ends early
+    while (std::fread(&r, sizeof(r), 1, f) == 1) out.push_back(r);
+  }
+  std::fclose(f);
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  int bucket = 250;
+  std::string csvPath;
+  std::vector<const char*> files;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (a == "--bucket" && hasValue) bucket = std::atoi(argv[++i]);
+    else if (a == "--csv" && hasValue) csvPath = argv[++i];
+    else if (!a.empty() && a[0] == '-') {
+      std::printf("unknown argument: %s\n", a.c_str());
+      return 2;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (files.empty() || bucket <= 0) {
+    std::printf("usage: telemetry_report [--bucket PX] [--csv FILE] FILE...\n");
+    return 2;
+  }
+
+  std::FILE* csv = csvPath.empty() ? nullptr : std::fopen(csvPath.c_str(), "w");
+  if (csv) std::fprintf(csv, "level,x,run_ms,file\n");
+
+  std::map<int, LevelStats> levels;
+  uint64_t totals[(int)telemetry::Event::Count + 1] = {};
+  double sessionSec = 0.0;
+  int sessions = 0;
+
+  telemetry::FileHeader h{};
+  std::vector<telemetry::Record> records;
+  for (const char* path : files) {
+    if (!readFile(path, h, records)) continue;
+    ++sessions;
+
+    const double freq = h.tickFrequency ? (double)h.tickFrequency : 1.0;
+    if (!records.empty()) sessionSec += (double)(records.back().ticks - h.startTicks) / freq;
+
+    for (const telemetry::Record& r : records) {
+      totals[std::min<int>(r.type, (int)telemetry::Event::Count)]++;
+      if (r.level == telemetry::kNoLevel) continue;
+
+      LevelStats& ls = levels[r.level];
+      if (r.type == (uint16_t)telemetry::Event::Death) {
+        ++ls.deaths;
+        ls.deathBuckets[(int)(std::max(0.0f, r.x) / (float)bucket)]++;
+        if (csv) std::fprintf(csv, "%u,%.1f,%u,%s\n", (unsigned)r.level + 1, r.x, r.a, path);
+      } else if (r.type == (uint16_t)telemetry::Event::LevelComplete) {
+        ++ls.completions;
+        ls.completionSec.push_back(r.a / 1000.0);
+      }
+    }
+  }
+  if (csv) std::fclose(csv);
+  if (sessions == 0) return 1;
+
+  std::printf("%d session(s), %.1f min of play\n\n", sessions, sessionSec / 60.0);
+  std::printf("events:\n");
+  for (int t = 0; t <= (int)telemetry::Event::Count; ++t) {
+    if (totals[t]) std::printf("  %-17s %llu\n", eventName((uint16_t)t), (unsigned long long)totals[t]);
+  }
+
+  for (const auto& kv : levels) {
+    const LevelStats& ls = kv.second;
+    const int attempts = ls.deaths + ls.completions;
+    if (attempts == 0) continue;
+
+    std::printf("\nlevel %d: %d attempts, %d deaths, %d completions (%.0f%%)\n",
+                kv.first + 1, attempts, ls.deaths, ls.completions, 100.0 * ls.completions / attempts);
+    if (!ls.completionSec.empty()) {
+      std::printf("  completion time: best %.2f s, median %.2f s\n",
+                  *std::min_element(ls.completionSec.begin(), ls.completionSec.end()), median(ls.completionSec));
+    }
+    if (ls.deathBuckets.empty()) continue;
+
+    // heat map: one row per bucket, bar scaled to the worst bucket
+    int worst = 0;
+    for (const auto& b : ls.deathBuckets) worst = std::max(worst, b.second);
+    std::printf("  deaths by x:\n");
+    for (const auto& b : ls.deathBuckets) {
+      const int len = (b.second * 40 + worst - 1) / worst;
+      std::printf("  %7d-%-7d %5d %s\n", b.first * bucket, (b.first + 1) * bucket, b.second,
+                  std::string((size_t)len, '#').c_str());
+    }
+  }
+  return 0;
+}